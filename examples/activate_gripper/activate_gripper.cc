@@ -43,12 +43,12 @@ int main(int argc, char* argv[]) {
 
   // Open the serial port
   robotiq::RobotiqGripperInterface gripper;
-  std::cout << "Connected: " << gripper.connect(port, baud) << "\n";
+  std::cout << "Connected: " << gripper.connect(port, baud).message() << "\n";
 
   // Activate the gripper.  That the gripper will not run activation if it is already
   // reset, so we reset first.
-  std::cout << "Reset: " << gripper.reset() << "\n";
-  std::cout << "Activate: " << gripper.activate() << "\n";
+  std::cout << "Reset: " << gripper.reset().message() << "\n";
+  std::cout << "Activate: " << gripper.activate().message() << "\n";
 
   return 0;
 }
@@ -43,17 +43,17 @@ int main(int argc, char* argv[]) {
 
   // Open the serial port
   robotiq::RobotiqGripperInterface gripper;
-  std::cout << "Connected: " << gripper.connect(port, baud) << "\n";
+  std::cout << "Connected: " << gripper.connect(port, baud).message() << "\n";
 
   // Check if gripper is activated and activate otherwise
-  if (not gripper.is_activated()) {
+  if (not gripper.is_activated().value()) {
     std::cout << "Gripper is not activated... Activating...";
     gripper.activate();
   }
   std::cout << "Gripper is activated!\n";
 
   // Close the gripper
-  std::cout << "Close gripper: " << gripper.close_gripper() << "\n";
+  std::cout << "Close gripper: " << gripper.close_gripper().message() << "\n";
 
   return 0;
 }
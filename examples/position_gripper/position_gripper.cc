@@ -55,24 +55,25 @@ int main(int argc, char* argv[]) {
 
   // Open the serial port
   robotiq::RobotiqGripperInterface gripper;
-  std::cout << "Connected: " << gripper.connect(port, baud, alpha, beta) << "\n";
+  std::cout << "Connected: " << gripper.connect(port, baud, alpha, beta).message()
+            << "\n";
 
   // Check if gripper is activated and activate otherwise
-  if (not gripper.is_activated()) {
+  if (not gripper.is_activated().value()) {
     std::cout << "Gripper is not activated... Activating...";
     gripper.activate();
   }
   std::cout << "Gripper is activated!\n";
 
   // Set the gripper to several positions
-  std::cout << "Move to 0.043: " << gripper.set_gripper_position(0.043) << "\n";
-  print_feedback(gripper.get_feedback());
+  std::cout << "Move to 0.043: " << gripper.set_gripper_position(0.043).message() << "\n";
+  print_feedback(gripper.get_feedback().value());
 
-  std::cout << "Move to 0: " << gripper.set_gripper_position(0) << "\n";
-  print_feedback(gripper.get_feedback());
+  std::cout << "Move to 0: " << gripper.set_gripper_position(0).message() << "\n";
+  print_feedback(gripper.get_feedback().value());
 
-  std::cout << "Move to 0.086: " << gripper.set_gripper_position(0.086) << "\n";
-  print_feedback(gripper.get_feedback());
+  std::cout << "Move to 0.086: " << gripper.set_gripper_position(0.086).message() << "\n";
+  print_feedback(gripper.get_feedback().value());
 
   return 0;
 }
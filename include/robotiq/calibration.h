@@ -0,0 +1,76 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace robotiq {
+
+/** A measured position at a position word */
+struct CalibrationPoint {
+  uint8_t word{0};     /** Between 0 (open) and 255 (closed) */
+  double position{0};  /** Measured position, e.g. the finger opening in m */
+};
+
+/**
+ * @brief Nonlinear position calibration of a gripper.  A forward table holds the position
+ * of every word, interpolated between measured points, and an inverse table holds the
+ * first word of each of 256 evenly spaced position bins.  to_position() is a lookup, and
+ * to_word() bisects the words of one bin, so a flat end of the curve costs at most eight
+ * comparisons.
+ *
+ * Calibration file format: the magic "RGCL", a uint32 version, then the 256 doubles of
+ * the forward table.  The inverse table is rebuilt when loading.
+ */
+class Calibration {
+ public:
+  /**
+   * @brief Builds the tables from measured points, which are sorted by word.  Words
+   * between points are interpolated linearly and words outside are extrapolated.
+   *
+   * @return False if there are less than two points with different words, or if the
+   * positions are not strictly monotonic in the word.
+   */
+  bool build(std::vector<CalibrationPoint> points);
+
+  /** @brief Writes the calibration to a file, returns true if succeeded. */
+  bool save(const std::string& path) const;
+
+  /** @brief Reads a calibration written by save(), returns true if succeeded. */
+  bool load(const std::string& path);
+
+  /** @brief Returns true once built or loaded. */
+  bool valid() const { return m_valid; }
+
+  /** @brief Returns the calibrated position of a word. */
+  double to_position(uint8_t word) const { return m_forward[word]; }
+
+  /** @brief Returns the word whose calibrated position is nearest, clamped to 0-255. */
+  uint8_t to_word(double position) const;
+
+ private:
+  bool build_inverse();
+
+  bool m_valid{false};
+  std::array<double, 256> m_forward{};
+  std::array<uint8_t, 256> m_inverse{};  // First word of each position bin
+  double m_inverse_origin{0};            // Position of the first inverse bin
+  double m_inverse_scale{0};             // Bins per position unit, negative if decreasing
+};
+
+}  // namespace robotiq
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace robotiq {
@@ -24,9 +25,24 @@ const std::string DEFAULT_PORT = "/dev/ttyUSB0";
 /** \brief Default port for MODBUS RTU (serial) communication */
 const std::size_t DEFAULT_BAUD = 115200;
 
+/** \brief Default MODBUS slave id of the gripper */
+const uint8_t DEFAULT_SLAVE_ID = 9;
+
 /** \brief Default inactivity timeout*/
 const std::size_t DEFAULT_RECEIVE_TIMEOUT_MS = 200;
 
+/** \brief Default time out for blocking actions to complete*/
+const std::size_t DEFAULT_MOTION_TIMEOUT_MS = 10000;
+
+/** \brief Default shared memory object name for published feedback */
+const std::string DEFAULT_SHARED_FEEDBACK_NAME = "/robotiq_gripper";
+
+/**
+ * \brief Default permissions of the shared feedback segment, owner only since readers can
+ * queue commands
+ */
+const uint32_t DEFAULT_SHARED_FEEDBACK_MODE = 0600;
+
 /** \brief Default slope scale factor */
 const double DEFAULT_SCALE_ALPHA = 1;
 
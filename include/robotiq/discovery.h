@@ -0,0 +1,83 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "robotiq/constants.h"
+#include "robotiq/result.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/transport.h"
+#include "robotiq/types.h"
+
+namespace robotiq {
+
+/** Options of discover_grippers() */
+struct DiscoveryOptions {
+  /** Slave ids tried in order on each port until one answers */
+  std::vector<uint8_t> slave_ids{DEFAULT_SLAVE_ID};
+
+  std::size_t baud{DEFAULT_BAUD};                     /** Baud rate of the ports */
+  SerialOptions serial;                               /** Options of the ports */
+  std::size_t probe_timeout_ms{20};                   /** Inactivity timeout of a probe */
+  std::size_t timeout_ms{DEFAULT_RECEIVE_TIMEOUT_MS}; /** Timeout once found */
+  bool activate{true};                                /** Activates if not activated */
+
+  /**
+   * Opens the transport of a port, returns null on failure.  Opens a SerialTransport
+   * with baud and serial if empty.
+   */
+  std::function<std::unique_ptr<Transport>(const std::string& port)> open_transport;
+
+  /**
+   * Connects a gripper to a transport, e.g. a RobotiqGripper<Model>.  Connects a
+   * RobotiqGripperInterface with the default scaling if empty.
+   */
+  std::function<std::unique_ptr<RobotiqGripperInterface>(std::unique_ptr<Transport>)>
+      connect_gripper;
+};
+
+/** Outcome of discover_grippers() on a port */
+struct DiscoveredGripper {
+  std::string port;
+  ErrorCode error{ErrorCode::NONE}; /** NONE if a gripper answered and is ready */
+  uint8_t slave_id{0};              /** Slave id that answered */
+  DetailedStatus status;            /** Status when probed, before the activation */
+  bool activated{false};            /** True if activated by the discovery */
+
+  /** Connected gripper, addressed to slave_id, or null if none answered */
+  std::unique_ptr<RobotiqGripperInterface> gripper;
+};
+
+/**
+ * @brief Brings up a cell of grippers in the time of the slowest one instead of the sum.
+ * Every port is handled on its own thread: the slave ids are probed in order with a
+ * short timeout, and the first gripper that answers is reported with its activation and
+ * fault state, then activated if needed while the other ports proceed.  A port holds one
+ * gripper, since a connected interface owns its port.
+ *
+ * @param[in]  ports  Serial ports, e.g. /dev/ttyUSB0 and /dev/ttyUSB1
+ * @param[in]  options  Probed slave ids, timeouts and activation
+ * @return One entry per port, in the order of the ports.
+ */
+std::vector<DiscoveredGripper> discover_grippers(const std::vector<std::string>& ports,
+                                                 const DiscoveryOptions& options = {});
+
+}  // namespace robotiq
@@ -0,0 +1,103 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "robotiq/types.h"
+
+namespace robotiq {
+
+/** Number of feedback samples kept by a FeedbackRing */
+const std::size_t FEEDBACK_RING_CAPACITY = 256;
+
+/**
+ * @brief Consecutive samples of a FeedbackRing, oldest first, as one contiguous array
+ * per field.  The arrays point into the ring and stay valid until its next push().
+ */
+struct FeedbackSpans {
+  std::size_t size{0};                            /** Number of samples */
+  const uint8_t* raw_position{nullptr};           /** 0 (open) to 255 (closed) */
+  const uint8_t* raw_commanded_position{nullptr}; /** 0 (open) to 255 (closed) */
+  const uint8_t* raw_current{nullptr};            /** 0 (min) to 255 (max) */
+  const uint8_t* status{nullptr};                 /** Packed, see pack_status() */
+  const int64_t* stamp_ns{nullptr};               /** Steady clock sample time in ns */
+};
+
+/**
+ * @brief Fixed-capacity history of the raw feedback in a structure-of-arrays layout, for
+ * filters such as velocity estimation that scan a field over many samples.  Each sample
+ * is written twice, at its slot and one capacity further, so the last n samples are
+ * always contiguous and queries return pointers without copying.
+ */
+class FeedbackRing {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /** Adds a sample, replacing the oldest once full; samples must be in time order */
+  void push(const GripperFeedback& feedback);
+
+  /** Forgets every sample */
+  void clear() { m_size = 0; }
+
+  /** Returns the number of samples held */
+  std::size_t size() const { return m_size; }
+
+  /** Returns the last count samples, or all of them if there are less */
+  FeedbackSpans last(std::size_t count) const;
+
+  /** Returns the samples whose estimated sample time is in [from, to] */
+  FeedbackSpans window(Clock::time_point from, Clock::time_point to) const;
+
+  /**
+   * @brief Returns the raw position at a time, interpolated between the samples around
+   * it, or extrapolated from the last two samples if the fingers were moving at the
+   * newest one, without passing the commanded position.
+   *
+   * @param[in]  time  Time of the position
+   * @param[out]  word  Fractional raw position, 0 (open) to 255 (closed)
+   * @return False without samples.
+   */
+  bool word_at(Clock::time_point time, double& word) const;
+
+  /**
+   * @brief Packs a status as in the first byte of the gripper status register: gOBJ in
+   * bits 7-6, gSTA in bits 5-4, gGTO in bit 3 and gACT in bit 0.
+   */
+  static uint8_t pack_status(const DetailedStatus& status);
+
+  /** Unpacks a status from pack_status(), its gflt is NONE */
+  static DetailedStatus unpack_status(uint8_t status);
+
+ private:
+  /** Returns the spans of count samples starting at the i-th oldest */
+  FeedbackSpans spans(std::size_t i, std::size_t count) const;
+
+  template <typename T>
+  using Field = std::array<T, 2 * FEEDBACK_RING_CAPACITY>;
+
+  Field<uint8_t> m_raw_position{};
+  Field<uint8_t> m_raw_commanded_position{};
+  Field<uint8_t> m_raw_current{};
+  Field<uint8_t> m_status{};
+  Field<int64_t> m_stamp_ns{};
+  std::size_t m_size{0};
+  std::size_t m_next{0};
+};
+
+}  // namespace robotiq
@@ -0,0 +1,121 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "robotiq/types.h"
+
+namespace robotiq {
+
+/** Largest window of the moving statistics of a GraspMonitor */
+const std::size_t GRASP_MONITOR_MAX_WINDOW = 64;
+
+/**
+ * @brief Mean and standard deviation over the last samples, in a fixed-size ring so that
+ * a push is O(1) and never allocates.
+ */
+class MovingStatistics {
+ public:
+  /** @param[in] window  Number of samples, clamped to 1 - GRASP_MONITOR_MAX_WINDOW */
+  explicit MovingStatistics(std::size_t window = 8);
+
+  /** @brief Adds a sample, replacing the oldest once the window is full. */
+  void push(double value);
+
+  /** @brief Removes every sample. */
+  void clear();
+
+  std::size_t size() const { return m_size; }
+  bool full() const { return m_size == m_window; }
+  double mean() const;
+  double stddev() const;
+
+ private:
+  std::array<double, GRASP_MONITOR_MAX_WINDOW> m_values{};
+  std::size_t m_window;
+  std::size_t m_size{0};
+  std::size_t m_next{0};
+  double m_sum{0};
+  double m_sum_squares{0};
+};
+
+/** Events detected by a GraspMonitor */
+enum class GraspEvent : uint8_t {
+  NONE,        /** Nothing changed */
+  CONTACT,     /** The fingers closed on an object */
+  SLIP,        /** The held object moved, so the fingers closed further */
+  OBJECT_LOST, /** The held object is gone, the fingers closed through it */
+};
+
+/** Thresholds of a GraspMonitor, the defaults suit the 2F-85 at full force */
+struct GraspMonitorConfig {
+  std::size_t window{8};          /** Samples in the moving statistics */
+  double contact_current{0.15};   /** Minimum current of a contact, 0 - 1 */
+  double contact_sigma{4};        /** Current rise over free motion, in std deviations */
+  double slip_words{2};           /** Closing travel while holding that is a slip */
+  double lost_current_ratio{0.3}; /** Fraction of the holding current when lost */
+};
+
+/**
+ * @brief Detects contact, slip and object loss online from the streamed feedback, so an
+ * application reacts one poll period after the event instead of after its own check.
+ *
+ * While the fingers close freely, the monitor tracks the mean and deviation of the
+ * current, and a contact is a current rise above both contact_current and contact_sigma
+ * deviations, or the gripper reporting that it stopped on an object.  While holding, it
+ * tracks the position and current once the fingers stopped on the object: the fingers
+ * closing slip_words past the mean holding position is a slip, reported once until they
+ * stop again, and the fingers reaching the commanded position, or stopping with a current
+ * below lost_current_ratio of the holding mean, is an object loss.  A new position
+ * command ends the grasp without an event.
+ *
+ * Every update is O(1) on fixed-size state, so it can run on each feedback sample, e.g.
+ * from RobotiqGripperInterface::set_feedback_callback().
+ */
+class GraspMonitor {
+ public:
+  explicit GraspMonitor(const GraspMonitorConfig& config = {});
+
+  /**
+   * @brief Analyzes a feedback sample.
+   *
+   * @param[in]  feedback  Newest feedback sample
+   * @return The event detected on this sample, or NONE.
+   */
+  GraspEvent update(const GripperFeedback& feedback);
+
+  /** @brief Returns true between a contact and the loss or release of the object. */
+  bool in_contact() const { return m_in_contact; }
+
+  /** @brief Forgets the grasp and the statistics. */
+  void reset();
+
+ private:
+  /** Ends the grasp, the next samples rebuild the free motion statistics */
+  void release();
+
+  GraspMonitorConfig m_config;
+  bool m_in_contact{false};
+  bool m_slipping{false};        // Slip reported, until the fingers stop again
+  uint8_t m_contact_command{0};  // Position command of the grasp
+  MovingStatistics m_free_current;
+  MovingStatistics m_holding_current;
+  MovingStatistics m_holding_position;
+};
+
+}  // namespace robotiq
@@ -0,0 +1,86 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "robotiq/result.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/types.h"
+
+namespace robotiq {
+
+/**
+ * @brief Commands several grippers as one batch, e.g. for dual-gripper handoffs.  All
+ * commands are written back to back from the calling thread before any response is
+ * awaited, so the grippers start moving as close to the same instant as the ports allow.
+ */
+class GripperGroup {
+ public:
+  /**
+   * @param[in]  grippers  Connected grippers, which must outlive the group
+   */
+  explicit GripperGroup(const std::vector<RobotiqGripperInterface*>& grippers);
+
+  /**
+   * @brief Sends one target per gripper as a batch and waits for every acknowledgement.
+   * The motion is not awaited, see wait_for_all() and wait_for_any().
+   *
+   * @param[in]  targets  Targets, in the order of the grippers
+   * @return The first error if a gripper did not acknowledge its command.
+   */
+  Result<void> set_gripper_positions(const std::vector<GripperTarget>& targets);
+
+  /**
+   * @brief Returns the measured start skew of the last batch, i.e. the time between
+   * the first and the last command leaving the host.
+   */
+  std::chrono::microseconds get_start_skew() const;
+
+  /**
+   * @brief Waits until every gripper has completed its motion.
+   *
+   * @param[in]  timeout  Maximum time to wait
+   * @return MOTION_TIMEOUT if a gripper did not complete before the timeout, or the
+   * error of a failed feedback read.
+   */
+  Result<void> wait_for_all(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Waits until any gripper has completed its motion.
+   *
+   * @param[in]  timeout  Maximum time to wait
+   * @return The index of the first gripper that completed, MOTION_TIMEOUT if none
+   * completed before the timeout, or the error of a failed feedback read.
+   */
+  Result<int> wait_for_any(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Returns the number of grippers in the group.
+   */
+  std::size_t size() const { return m_grippers.size(); }
+
+ private:
+  /** Polls a gripper and returns true if it completed the last commanded motion */
+  Result<bool> is_done(std::size_t index);
+
+  std::vector<RobotiqGripperInterface*> m_grippers;
+  std::vector<uint8_t> m_commanded;
+  std::chrono::microseconds m_start_skew{0};
+};
+
+}  // namespace robotiq
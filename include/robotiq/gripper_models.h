@@ -0,0 +1,181 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "robotiq/robotiq_gripper_interface.h"
+
+namespace robotiq {
+
+/*
+ * Model policies hold the ranges of a gripper model from its manual, in SI units:
+ *
+ *   stroke                Maximum finger opening in m
+ *   min_speed, max_speed  Finger speed range in m/s
+ *   min_force, max_force  Grip force range in N
+ *   activation_settle_ms  Wait after gACT rises before the fingers accept commands
+ *
+ * The 2F-85, 2F-140 and Hand-E share the same register map, so the policies only differ
+ * in their ranges and timing.
+ */
+
+/** Policy of the 2F-85 2-finger gripper, whose settle time was measured on hardware */
+struct Robotiq2F85 {
+  static constexpr double stroke = 0.085;
+  static constexpr double min_speed = 0.020;
+  static constexpr double max_speed = 0.150;
+  static constexpr double min_force = 20;
+  static constexpr double max_force = 235;
+  static constexpr std::size_t activation_settle_ms = 2000;
+};
+
+/** Policy of the 2F-140 2-finger gripper */
+struct Robotiq2F140 {
+  static constexpr double stroke = 0.140;
+  static constexpr double min_speed = 0.030;
+  static constexpr double max_speed = 0.250;
+  static constexpr double min_force = 10;
+  static constexpr double max_force = 125;
+  static constexpr std::size_t activation_settle_ms = 2000;
+};
+
+/** Policy of the Hand-E parallel gripper */
+struct RobotiqHandE {
+  static constexpr double stroke = 0.050;
+  static constexpr double min_speed = 0.020;
+  static constexpr double max_speed = 0.150;
+  static constexpr double min_force = 20;
+  static constexpr double max_force = 185;
+  static constexpr std::size_t activation_settle_ms = 1500;
+};
+
+/** Largest stroke of a supported gripper in m, used to catch unit mistakes */
+constexpr double MAX_STROKE = 0.25;
+
+/**
+ * @brief Conversions between SI units and register words for a model policy.  The
+ * slopes are computed at compile time, so each conversion is a clamped multiply-add.
+ * The raw position word is 0 when open and 255 when closed, i.e. at zero width.
+ */
+template <typename Model>
+struct ModelScaling {
+  static_assert(Model::stroke > 0 && Model::stroke <= MAX_STROKE,
+                "The stroke must be in m, positive and at most MAX_STROKE");
+  static_assert(Model::min_speed > 0 && Model::min_speed < Model::max_speed,
+                "The speed range must be positive and not empty");
+  static_assert(Model::min_force > 0 && Model::min_force < Model::max_force,
+                "The force range must be positive and not empty");
+
+  static constexpr double WORDS_PER_METER = 255.0 / Model::stroke;
+  static constexpr double METERS_PER_WORD = Model::stroke / 255.0;
+  static constexpr double WORDS_PER_SPEED = 255.0 / (Model::max_speed - Model::min_speed);
+  static constexpr double WORDS_PER_FORCE = 255.0 / (Model::max_force - Model::min_force);
+
+  /** Rounds to the nearest word, clamping out of range values */
+  static constexpr uint8_t to_word(double word) {
+    return word <= 0 ? 0 : word >= 255 ? 255 : static_cast<uint8_t>(word + 0.5);
+  }
+
+  /** Converts a finger opening in m to a position word */
+  static constexpr uint8_t width_to_word(double width) {
+    return to_word((Model::stroke - width) * WORDS_PER_METER);
+  }
+
+  /** Converts a position word to a finger opening in m */
+  static constexpr double word_to_width(uint8_t word) {
+    return Model::stroke - METERS_PER_WORD * word;
+  }
+
+  /** Converts a finger speed in m/s to a speed word */
+  static constexpr uint8_t speed_to_word(double speed) {
+    return to_word((speed - Model::min_speed) * WORDS_PER_SPEED);
+  }
+
+  /** Converts a grip force in N to a force word */
+  static constexpr uint8_t force_to_word(double force) {
+    return to_word((force - Model::min_force) * WORDS_PER_FORCE);
+  }
+};
+
+/**
+ * @brief RobotiqGripperInterface specialized for a gripper model, e.g.
+ * RobotiqGripper<Robotiq2F140>.  Positions are finger openings in m, so the feedback
+ * position is the opening as well, and the activation waits the settle time of the
+ * model.
+ */
+template <typename Model>
+class RobotiqGripper : public RobotiqGripperInterface {
+ public:
+  using Scaling = ModelScaling<Model>;
+
+  // Instantiates the scaling so that its static_asserts check the model
+  static_assert(sizeof(Scaling) > 0, "The model policy must be valid");
+
+  RobotiqGripper() {
+    ModelParameters parameters;
+    parameters.activation_settle_ms = Model::activation_settle_ms;
+    parameters.full_stroke_time_s = Model::stroke / Model::max_speed;
+    parameters.min_speed_ratio = Model::min_speed / Model::max_speed;
+    set_model_parameters(parameters);
+  }
+
+  /**
+   * @brief Connects to the gripper over MODBUS RTU with positions scaled to the finger
+   * opening in m.
+   *
+   * @param[in] port  Serial port for communication (Ubuntu default: /dev/ttyUSB0)
+   * @param[in] baud  Baud rate (default: 115200)
+   * @return The error if failed.
+   */
+  Result<void> connect(const std::string& port = DEFAULT_PORT,
+                       std::size_t baud = DEFAULT_BAUD) {
+    return RobotiqGripperInterface::connect(port, baud, -Model::stroke, Model::stroke);
+  }
+
+  /**
+   * @brief Connects to the gripper over the given transport with positions scaled to the
+   * finger opening in m.
+   *
+   * @param[in] transport  Opened transport
+   * @return The error if failed.
+   */
+  Result<void> connect(std::unique_ptr<Transport> transport) {
+    return RobotiqGripperInterface::connect(std::move(transport), -Model::stroke,
+                                            Model::stroke);
+  }
+
+  /**
+   * @brief Moves the fingers to an opening with the given speed and force, clamped to the
+   * ranges of the model.
+   *
+   * @param[in]  width  Finger opening in m
+   * @param[in]  speed  Finger speed in m/s
+   * @param[in]  force  Grip force in N
+   * @param[in]  blocking  Waits to return until the gripper has completed the action.
+   * @return The error if failed.
+   */
+  Result<void> set_width(double width, double speed = Model::max_speed,
+                         double force = Model::max_force, bool blocking = true) {
+    return set_raw_gripper_position(Scaling::width_to_word(width),
+                                    Scaling::speed_to_word(speed),
+                                    Scaling::force_to_word(force), blocking);
+  }
+};
+
+}  // namespace robotiq
@@ -0,0 +1,64 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "robotiq/result.h"
+
+namespace robotiq {
+
+/** Largest number of registers in a single read or write message */
+const uint16_t MAX_REGISTER_COUNT = 123;
+
+/** Register table of a read, selecting its Modbus function code */
+enum class RegisterTable : uint8_t {
+  HOLDING = 0x03, /** Read holding registers (FC03) */
+  INPUT = 0x04,   /** Read input registers (FC04) */
+};
+
+/**
+ * @brief Read of consecutive registers, queued with
+ * RobotiqGripperInterface::queue_request() and filled by execute_requests().
+ */
+struct RegisterRead {
+  RegisterRead() = default;
+  RegisterRead(RegisterTable table, uint16_t address, uint16_t count)
+      : table(table), address(address), count(count) {}
+
+  RegisterTable table{RegisterTable::HOLDING};
+  uint16_t address{0};              /** Address of the first register */
+  uint16_t count{1};                /** Number of registers, 1 - MAX_REGISTER_COUNT */
+  std::vector<uint16_t> values;     /** Values read, count of them on success */
+  ErrorCode error{ErrorCode::NONE}; /** Outcome of the read */
+};
+
+/**
+ * @brief Write of consecutive registers (FC16), queued with
+ * RobotiqGripperInterface::queue_request() and sent by execute_requests().
+ */
+struct RegisterWrite {
+  RegisterWrite() = default;
+  RegisterWrite(uint16_t address, std::vector<uint16_t> values)
+      : address(address), values(std::move(values)) {}
+
+  uint16_t address{0};              /** Address of the first register */
+  std::vector<uint16_t> values;     /** Values, 1 - MAX_REGISTER_COUNT of them */
+  ErrorCode error{ErrorCode::NONE}; /** Outcome of the write */
+};
+
+}  // namespace robotiq
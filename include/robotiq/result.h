@@ -0,0 +1,106 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <system_error>
+#include <type_traits>
+
+namespace robotiq {
+
+/** Reasons for a call to fail */
+enum class ErrorCode : uint8_t {
+  NONE,                /** Succeeded */
+  NOT_CONNECTED,       /** connect() was not called or failed */
+  PORT_ERROR,          /** The port could not be opened or written, e.g. unplugged */
+  TIMEOUT,             /** No response, or an incomplete one, within the timeout */
+  BAD_CRC,             /** The response was corrupted on the bus */
+  UNEXPECTED_RESPONSE, /** The response does not answer the request */
+  MODBUS_EXCEPTION,    /** The gripper rejected the request with an exception */
+  MOTION_TIMEOUT,      /** The gripper did not complete the action in time */
+  INVALID_ARGUMENT,    /** The request cannot be sent as given */
+  FILE_ERROR,          /** A file could not be read or written */
+};
+
+/** Returns a static description of an error code, never allocates */
+const char* to_string(ErrorCode code);
+
+/** Returns the std::error_category of ErrorCode */
+const std::error_category& error_category();
+
+/** Converts an ErrorCode to a std::error_code */
+inline std::error_code make_error_code(ErrorCode code) {
+  return std::error_code(static_cast<int>(code), error_category());
+}
+
+/**
+ * @brief Either a value or the error that prevented it, in the spirit of std::expected.
+ * Results are returned by value and the error path holds a single byte, so failing does
+ * not allocate and callers can branch on the error code immediately:
+ *
+ *   auto feedback = gripper.get_feedback();
+ *   if (not feedback && feedback.error() == ErrorCode::TIMEOUT) { ... retry ... }
+ *
+ * value() returns a default constructed value on error.  A Result<bool> does not convert
+ * to bool, since testing it would read as testing the value: call has_value() or value().
+ */
+template <typename T>
+class Result {
+ public:
+  Result(const T& value) : m_value(value) {}
+  Result(ErrorCode error) : m_error(error) {}
+
+  bool has_value() const { return m_error == ErrorCode::NONE; }
+  explicit operator bool() const {
+    static_assert(not std::is_same<T, bool>::value,
+                  "Ambiguous test of a Result<bool>, call has_value() or value()");
+    return has_value();
+  }
+
+  const T& value() const { return m_value; }
+  const T& operator*() const { return m_value; }
+  const T* operator->() const { return &m_value; }
+
+  ErrorCode error() const { return m_error; }
+  const char* message() const { return to_string(m_error); }
+
+ private:
+  T m_value{};
+  ErrorCode m_error{ErrorCode::NONE};
+};
+
+/** @brief Result of a call that returns no value. */
+template <>
+class Result<void> {
+ public:
+  Result() = default;
+  Result(ErrorCode error) : m_error(error) {}
+
+  bool has_value() const { return m_error == ErrorCode::NONE; }
+  explicit operator bool() const { return has_value(); }
+
+  ErrorCode error() const { return m_error; }
+  const char* message() const { return to_string(m_error); }
+
+ private:
+  ErrorCode m_error{ErrorCode::NONE};
+};
+
+}  // namespace robotiq
+
+namespace std {
+template <>
+struct is_error_code_enum<robotiq::ErrorCode> : true_type {};
+}  // namespace std
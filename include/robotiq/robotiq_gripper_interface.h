@@ -14,12 +14,19 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "robotiq/calibration.h"
 #include "robotiq/constants.h"
+#include "robotiq/feedback_ring.h"
+#include "robotiq/registers.h"
+#include "robotiq/result.h"
+#include "robotiq/transport.h"
 #include "robotiq/types.h"
 
 namespace robotiq {
@@ -31,6 +38,8 @@ namespace robotiq {
  *
  * Note that the class was tested with a 2F-85 2-finger gripper, Robotiq pinout to RS-485
  * board, an RS-485 serial to usb converter, and a Z6 workstation running Ubuntu 16.04.
+ * RobotiqGripper in robotiq/gripper_models.h specializes the interface for the 2F-85,
+ * 2F-140 and Hand-E with their stroke, speed and force ranges, and activation timing.
  */
 class RobotiqGripperInterface {
  public:
@@ -66,64 +75,189 @@ class RobotiqGripperInterface {
    * @param[in] baud  Baud rate (default: 115200)
    * @param[in] scale_alpha Linear slope factor for position scaling
    * @param[in] scale_beta Linear zero crossing factor for position scaling
-   * @return True if succeeded.
+   * @return The error if failed.
+   */
+  Result<void> connect(const std::string& port = DEFAULT_PORT,
+                       std::size_t baud = DEFAULT_BAUD,
+                       double scale_alpha = DEFAULT_SCALE_ALPHA,
+                       double scale_beta = DEFAULT_SCALE_BETA);
+
+  /**
+   * @brief Connects to the gripper over the given transport, e.g. a ReplayTransport to
+   * reproduce a wire capture offline, or a CaptureTransport wrapping a SerialTransport to
+   * record one.  See the other overload for the scale factors.
+   *
+   * @param[in] transport  Opened transport
+   * @param[in] scale_alpha Linear slope factor for position scaling
+   * @param[in] scale_beta Linear zero crossing factor for position scaling
+   * @return The error if failed.
    */
-  bool connect(const std::string& port = DEFAULT_PORT, std::size_t baud = DEFAULT_BAUD,
-               double scale_alpha = DEFAULT_SCALE_ALPHA,
-               double scale_beta = DEFAULT_SCALE_BETA);
+  Result<void> connect(std::unique_ptr<Transport> transport,
+                       double scale_alpha = DEFAULT_SCALE_ALPHA,
+                       double scale_beta = DEFAULT_SCALE_BETA);
 
   /**
    * @brief Resets (deactivates) the gripper.
    *
    * @param[in]  blocking  Waits to return until the gripper has completed the action.
-   * @return True if succeeded.
+   * @return The error if failed.
    */
-  bool reset(bool blocking = true);
+  Result<void> reset(bool blocking = true);
 
   /**
    * @brief Activates the gripper, which will cause the gripper to move.
    *
    * @param[in]  blocking  Waits to return until the gripper has completed the action.
-   * @return True if succeeded.
+   * @return The error if failed.
    */
-  bool activate(bool blocking = true);
+  Result<void> activate(bool blocking = true);
 
   /**
    * @brief Checks if the gripper is activated.
    *
-   * @return True if activated.
+   * @return True if activated, or the error if failed.
    */
-  bool is_activated();
+  Result<bool> is_activated();
 
   /**
    * @brief Closes the gripper until position reached or obstacle encountered.
    *
    * @param[in]  blocking  Waits to return until the gripper has completed the action.
-   * @return True if succeeded.
+   * @return The error if failed.
    */
-  bool close_gripper(bool blocking = true);
+  Result<void> close_gripper(bool blocking = true);
 
   /**
    * @brief Opens the gripper until position reached or obstacle encountered.
    *
    * @param[in]  blocking  Waits to return until the gripper has completed the action.
-   * @return True if succeeded.
+   * @return The error if failed.
    */
-  bool open_gripper(bool blocking = true);
+  Result<void> open_gripper(bool blocking = true);
 
   /**
    * @brief Sets the gripper position.
    *
    * @param[in]  position  Desired position, scaled by the scale factors
    * @param[in]  blocking  Waits to return until the gripper has completed the action.
-   * @return True if succeeded.
+   * @return The error if failed.
    */
-  bool set_gripper_position(double position, bool blocking = true);
+  Result<void> set_gripper_position(double position, bool blocking = true);
+
+  /**
+   * @brief Sets the gripper position with the given speed and force.
+   *
+   * @param[in]  position  Desired position, scaled by the scale factors
+   * @param[in]  speed  Between 0 (min) and 1 (max)
+   * @param[in]  force  Between 0 (min) and 1 (max)
+   * @param[in]  blocking  Waits to return until the gripper has completed the action.
+   * @return The error if failed.
+   */
+  Result<void> set_gripper_position(double position, double speed, double force,
+                                    bool blocking = true);
+
+  /**
+   * @brief Grasps an object of roughly known width.  The fingers approach fast until the
+   * slowdown margin, then close slowly with limited force.  Returns as soon as the
+   * gripper reports that it stopped on an object.
+   *
+   * @param[in]  profile  Expected object width and speed/force profile
+   * @return True if an object was grasped, or the error if failed.
+   */
+  Result<bool> grasp(const GraspProfile& profile);
 
   /**
    * @brief Returns the gripper feedback.
+   *
+   * @return The feedback, or the error if failed.
+   */
+  Result<GripperFeedback> get_feedback();
+
+  /**
+   * @brief Reads consecutive holding registers (FC03 from the manual).  The gripper
+   * output registers start at 0x03E8 and the input (status) registers at 0x07D0.
+   *
+   * @param[in]  address  Address of the first register
+   * @param[in]  count  Number of registers to read
+   * @param[out]  values  Register values, resized to count
+   * @return The error if failed.
+   */
+  Result<void> read_registers(uint16_t address, uint16_t count,
+                              std::vector<uint16_t>& values);
+
+  /**
+   * @brief Writes consecutive registers (FC16 from the manual).
+   *
+   * @param[in]  address  Address of the first register
+   * @param[in]  values  Register values
+   * @return The error if failed.
+   */
+  Result<void> write_registers(uint16_t address, const std::vector<uint16_t>& values);
+
+  /**
+   * @brief Queues a register read or write for execute_requests(), e.g. to monitor more
+   * state in each control cycle.  The request must stay alive until then.
+   */
+  void queue_request(RegisterRead& read);
+  void queue_request(RegisterWrite& write);
+
+  /**
+   * @brief Executes the queued requests in order and empties the queue.  The reads of a
+   * table queued between two writes that are adjacent or overlap are merged into one
+   * FC03 or FC04 transaction, and the values are split back to each read, so the number
+   * of transactions does not grow with the number of readers.
+   *
+   * @return The first error if a request failed, each request holds its own outcome.
+   */
+  Result<void> execute_requests();
+
+  /**
+   * @brief Sets the calibration file of this gripper.  connect() loads the calibration
+   * from the file if it exists, and calibrate() saves to it.
+   */
+  void set_calibration_path(const std::string& path);
+
+  /**
+   * @brief Replaces the linear scale factors with a nonlinear calibration, e.g. one
+   * built from a measured table.  Positions are then in the units of the calibration.
+   *
+   * @return True if the calibration is valid.
+   */
+  bool set_calibration(const Calibration& calibration);
+
+  /**
+   * @brief Sweeps the gripper over evenly spaced words, measures the position reached at
+   * each one with the given function, e.g. reading a gauge, and uses the resulting
+   * calibration.  Saves it to the calibration file if one was set.
+   *
+   * @param[in]  measure  Returns the measured position for the raw position reached
+   * @param[in]  points  Number of points of the sweep, at least 2
+   * @return The error if failed.
+   */
+  Result<void> calibrate(const std::function<double(uint8_t)>& measure,
+                         std::size_t points = 18);
+
+  /**
+   * @brief Sets the MODBUS slave id the requests are addressed to (default: 9).
+   */
+  void set_slave_id(uint8_t slave_id);
+
+  /**
+   * @brief Returns the MODBUS slave id the requests are addressed to.
+   */
+  uint8_t get_slave_id() const;
+
+  /**
+   * @brief Sets the serial port options applied by the next connect() to a port, e.g.
+   * the opt-in low-latency mode.
    */
-  GripperFeedback get_feedback();
+  void set_serial_options(const SerialOptions& options);
+
+  /**
+   * @brief Returns the low-latency settings that took effect at the last connect() to a
+   * port.
+   */
+  SerialLatencyReport get_serial_report() const;
 
   /**
    * @brief Sets the time out in ms for receiving messages from the gripper.
@@ -135,9 +269,138 @@ class RobotiqGripperInterface {
    */
   std::size_t get_timeout() const;
 
+  /**
+   * @brief Sets the time out in ms for blocking actions to complete, after which they
+   * fail with ErrorCode::MOTION_TIMEOUT.
+   */
+  void set_motion_timeout(std::size_t timeout_ms);
+
+  /**
+   * @brief Returns the time out in ms for blocking actions to complete.
+   */
+  std::size_t get_motion_timeout() const;
+
+  /**
+   * @brief Sets the freshness window of the register shadow cache, which is maintained
+   * from every transaction.  Within the window of the last feedback, is_activated() is
+   * answered from the shadow registers, and a position command equal to the confirmed
+   * command, that the feedback shows being executed without a fault, is skipped.  Zero
+   * (default) disables the cache.  get_feedback() always reads the gripper.
+   */
+  void set_cache_freshness(std::size_t freshness_ms);
+
+  /**
+   * @brief Returns the freshness window of the register shadow cache in ms.
+   */
+  std::size_t get_cache_freshness() const;
+
+  /**
+   * @brief Returns the bus transactions sent, and those saved by the register cache.
+   */
+  RegisterCacheStats get_cache_stats() const;
+
+  /**
+   * @brief Returns the estimated time in seconds until the fingers reach the commanded
+   * position.  The estimate is computed from the last feedback sample and a kinematic
+   * model learned online, so no message is sent to the gripper.
+   *
+   * @return Zero if the gripper was not in motion at the last feedback sample.
+   */
+  double estimated_time_to_target() const;
+
+  /**
+   * @brief Returns the finger position at a steady clock time, e.g. the capture time of
+   * a camera frame.  The position is interpolated between the recent feedback samples at
+   * their estimated sample times (see FeedbackTiming), or extrapolated from the last two
+   * while the fingers move, up to the commanded position.  No message is sent.
+   *
+   * @param[in]  time  Time of the position
+   * @param[out]  position  Position, scaled by the scale factors
+   * @return False if no feedback was read since the connection.
+   */
+  bool position_at(std::chrono::steady_clock::time_point time, double& position) const;
+
+  /**
+   * @brief Returns the most recent feedback samples read since the connection, up to
+   * FEEDBACK_RING_CAPACITY, as one contiguous array of raw values per field (see
+   * FeedbackRing).  Nothing is copied, so it can be called every control cycle; the
+   * arrays are valid until the next feedback is read.
+   *
+   * @param[in]  count  Number of samples, all of them if there are less
+   * @return Spans of the samples, oldest first.
+   */
+  FeedbackSpans get_feedback_history(std::size_t count) const;
+
+  /**
+   * @brief Returns the recent feedback samples whose estimated sample time (see
+   * FeedbackTiming) is between from and to included, as get_feedback_history(count).
+   */
+  FeedbackSpans get_feedback_history(std::chrono::steady_clock::time_point from,
+                                     std::chrono::steady_clock::time_point to) const;
+
+  /**
+   * @brief Enables or disables motion-model-predicted polling for blocking moves.  When
+   * enabled (default), feedback polls are sparse early in a move and dense near arrival,
+   * which frees bus capacity for other devices on the line.
+   */
+  void set_predictive_polling(bool enabled);
+
+  /**
+   * @brief Records every feedback sample and command from now on to a binary telemetry
+   * log (see robotiq/telemetry.h), with raw registers, timestamps and latency.  Samples
+   * are queued to a lock-free ring and written to the memory mapped log by a background
+   * thread.  Read the log with robotiq::TelemetryReader.
+   *
+   * @param[in] path  Log file path, truncated if it exists
+   * @return True if succeeded.
+   */
+  bool record_telemetry(const std::string& path);
+
+  /**
+   * @brief Publishes every feedback sample from now on to a POSIX shared memory segment.
+   * Other processes can then read the feedback and queue commands with
+   * robotiq::SharedFeedbackReader without owning the serial port.  Readers can move the
+   * gripper, so the segment is only accessible to the owner's user by default; use e.g.
+   * 0660 to allow the group of the owner.
+   *
+   * @param[in] name  Shared memory object name
+   * @param[in] mode  Permissions of the segment
+   * @return True if succeeded.
+   */
+  bool publish_feedback(const std::string& name = DEFAULT_SHARED_FEEDBACK_NAME,
+                        uint32_t mode = DEFAULT_SHARED_FEEDBACK_MODE);
+
+  /**
+   * @brief Calls a function with every feedback sample from now on, including the polls
+   * of blocking actions, e.g. to run a robotiq::GraspMonitor.  The function runs on the
+   * polling thread, so it must return quickly.  An empty function removes it.
+   */
+  void set_feedback_callback(std::function<void(const GripperFeedback&)> callback);
+
+  /**
+   * @brief Executes the commands queued by shared memory readers.  The commands are sent
+   * without blocking, so this is meant to be called from the owner's polling loop.
+   *
+   * @return The number of commands executed.
+   */
+  std::size_t process_shared_commands();
+
+ protected:
+  /** Sets the timing and kinematics of the gripper model, the 2F-85 by default */
+  void set_model_parameters(const ModelParameters& parameters);
+
+  /** Writes the raw words (unscaled) to position, speed, and force */
+  Result<void> set_raw_gripper_position(uint8_t position, uint8_t speed, uint8_t force,
+                                        bool blocking);
+
  private:
-  /** Writes the raw word (unscaled) to position */
-  bool set_raw_gripper_position(uint8_t position, bool blocking);
+  friend class GripperGroup;
+
+  /** Writes a raw position command without waiting for the response */
+  Result<void> send_raw_position_command(uint8_t position, uint8_t speed, uint8_t force);
+
+  /** Waits for the response to a preset command */
+  Result<void> receive_preset_response();
 
   /** Scales the raw word to position */
   double word_to_position(uint8_t word) const;
@@ -0,0 +1,305 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "robotiq/types.h"
+
+/*
+ * Header-only access to the feedback published in shared memory by the process that owns
+ * the serial port (see RobotiqGripperInterface::publish_feedback).  Reading the newest
+ * sample or the recent history does not make any system call once the segment is
+ * mapped.  Commands are sent to the owner through a shared-memory request queue.
+ */
+
+namespace robotiq {
+namespace shm {
+
+/** Identifies a robotiq feedback segment */
+const uint32_t SEGMENT_MAGIC = 0x52475346;
+
+/** Layout version of the segment, bumped on any change to the structures below */
+const uint32_t SEGMENT_VERSION = 3;
+
+/** Number of feedback samples kept in the ring (power of two) */
+const std::size_t HISTORY_CAPACITY = 256;
+
+/** Number of pending commands the request queue can hold (power of two) */
+const std::size_t COMMAND_CAPACITY = 64;
+
+/** Attempts to read the newest slot, which only fail while the publisher writes it */
+const std::size_t READ_ATTEMPTS = 1024;
+
+static_assert(std::is_trivially_copyable<GripperFeedback>::value,
+              "GripperFeedback must be trivially copyable to be shared");
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "Shared memory synchronization requires lock-free 32 and 64 bit atomics");
+
+/** A feedback sample with its publication index and steady clock timestamp */
+struct Sample {
+  uint64_t index{0};    /** Sequential number of the sample since the publisher started */
+  int64_t stamp_ns{0};  /** std::chrono::steady_clock time of the sample in ns */
+  GripperFeedback feedback{};
+};
+
+/** Commands that can be requested from the bus owner */
+enum CommandType : uint32_t {
+  COMMAND_RESET,
+  COMMAND_ACTIVATE,
+  COMMAND_OPEN,
+  COMMAND_CLOSE,
+  COMMAND_POSITION,
+};
+
+/** A command request; the owner executes all commands without blocking */
+struct Command {
+  CommandType type{COMMAND_POSITION};
+  double position{0}; /** Scaled position, only used by COMMAND_POSITION */
+};
+
+/** Ring slot guarded by a seqlock: the sequence is odd while the slot is written */
+struct SampleSlot {
+  std::atomic<uint32_t> sequence{0};
+  Sample sample;
+};
+
+/** Request queue cell, see the bounded MPMC queue of D. Vyukov */
+struct CommandCell {
+  std::atomic<uint64_t> sequence{0};
+  Command command;
+};
+
+/** Memory layout of the shared segment */
+struct Segment {
+  std::atomic<uint32_t> magic{0};  // Stored last, once the segment is initialized
+  uint32_t version{0};
+  alignas(64) std::atomic<uint64_t> published{0};
+  alignas(64) std::atomic<uint64_t> command_enqueue{0};
+  alignas(64) std::atomic<uint64_t> command_dequeue{0};
+  alignas(64) SampleSlot samples[HISTORY_CAPACITY];
+  CommandCell commands[COMMAND_CAPACITY];
+};
+
+/** Reads a ring slot, returning false if it was being written or holds another sample */
+inline bool read_slot(const Segment& segment, uint64_t index, Sample& sample) {
+  const SampleSlot& slot = segment.samples[index % HISTORY_CAPACITY];
+  uint32_t before = slot.sequence.load(std::memory_order_acquire);
+  if (before & 1) {
+    return false;
+  }
+  std::memcpy(&sample, &slot.sample, sizeof(Sample));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint32_t after = slot.sequence.load(std::memory_order_relaxed);
+  return before == after && sample.index == index;
+}
+
+/** Writes the next ring slot; only the bus owner may call this */
+inline void write_slot(Segment& segment, const Sample& sample) {
+  SampleSlot& slot = segment.samples[sample.index % HISTORY_CAPACITY];
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&slot.sample, &sample, sizeof(Sample));
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+  segment.published.store(sample.index + 1, std::memory_order_release);
+}
+
+/** Adds a command to the request queue, returns false if the queue is full */
+inline bool push_command(Segment& segment, const Command& command) {
+  uint64_t position = segment.command_enqueue.load(std::memory_order_relaxed);
+  while (true) {
+    CommandCell& cell = segment.commands[position % COMMAND_CAPACITY];
+    uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+    if (diff == 0) {
+      if (segment.command_enqueue.compare_exchange_weak(position, position + 1,
+                                                        std::memory_order_relaxed)) {
+        cell.command = command;
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = segment.command_enqueue.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/** Removes a command from the request queue, returns false if the queue is empty */
+inline bool pop_command(Segment& segment, Command& command) {
+  uint64_t position = segment.command_dequeue.load(std::memory_order_relaxed);
+  while (true) {
+    CommandCell& cell = segment.commands[position % COMMAND_CAPACITY];
+    uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+    if (diff == 0) {
+      if (segment.command_dequeue.compare_exchange_weak(position, position + 1,
+                                                        std::memory_order_relaxed)) {
+        command = cell.command;
+        cell.sequence.store(position + COMMAND_CAPACITY, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = segment.command_dequeue.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/** Initializes a freshly mapped segment; only the bus owner may call this */
+inline void initialize(Segment& segment) {
+  new (&segment) Segment();
+  for (std::size_t i = 0; i < COMMAND_CAPACITY; ++i) {
+    segment.commands[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  segment.version = SEGMENT_VERSION;
+  // Readers that see the magic also see the initialized queue and version
+  segment.magic.store(SEGMENT_MAGIC, std::memory_order_release);
+}
+
+}  // namespace shm
+
+/**
+ * @brief Reads the gripper feedback published in shared memory by another process and
+ * sends it commands.  Once connected, no call makes a system call.
+ */
+class SharedFeedbackReader {
+ public:
+  SharedFeedbackReader() = default;
+  SharedFeedbackReader(const SharedFeedbackReader&) = delete;
+  SharedFeedbackReader& operator=(const SharedFeedbackReader&) = delete;
+  ~SharedFeedbackReader() { disconnect(); }
+
+  /**
+   * @brief Maps the shared segment created by the bus owner.
+   *
+   * @param[in] name  Shared memory object name used by the publisher
+   * @return True if succeeded.
+   */
+  bool connect(const std::string& name = DEFAULT_SHARED_FEEDBACK_NAME) {
+    disconnect();
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      return false;
+    }
+    // The publisher sizes the object after creating it, mapping it before would fault
+    struct stat status;
+    if (fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) < sizeof(shm::Segment)) {
+      close(fd);
+      return false;
+    }
+    void* address =
+        mmap(nullptr, sizeof(shm::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+      return false;
+    }
+    m_segment = static_cast<shm::Segment*>(address);
+    if (m_segment->magic.load(std::memory_order_acquire) != shm::SEGMENT_MAGIC ||
+        m_segment->version != shm::SEGMENT_VERSION) {
+      disconnect();
+      return false;
+    }
+    return true;
+  }
+
+  /** @brief Unmaps the shared segment. */
+  void disconnect() {
+    if (m_segment != nullptr) {
+      munmap(m_segment, sizeof(shm::Segment));
+      m_segment = nullptr;
+    }
+  }
+
+  /** @brief Returns true if the shared segment is mapped. */
+  bool is_connected() const { return m_segment != nullptr; }
+
+  /**
+   * @brief Reads the newest published sample.
+   *
+   * @return False if nothing was published yet, or if the slot stayed half written
+   * over shm::READ_ATTEMPTS reads, e.g. when the publisher died while writing it.
+   */
+  bool latest(shm::Sample& sample) const {
+    if (m_segment == nullptr) {
+      return false;
+    }
+    for (std::size_t attempt = 0; attempt < shm::READ_ATTEMPTS; ++attempt) {
+      uint64_t published = m_segment->published.load(std::memory_order_acquire);
+      if (published == 0) {
+        return false;
+      }
+      if (shm::read_slot(*m_segment, published - 1, sample)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Reads up to count of the most recent samples, oldest first.  Samples that are
+   * overwritten by the publisher while reading are dropped from the front.
+   */
+  std::vector<shm::Sample> history(std::size_t count) const {
+    std::vector<shm::Sample> samples;
+    if (m_segment == nullptr) {
+      return samples;
+    }
+    uint64_t published = m_segment->published.load(std::memory_order_acquire);
+    count = std::min<uint64_t>({count, published, shm::HISTORY_CAPACITY});
+    samples.resize(count);
+    std::size_t valid = 0;
+    for (uint64_t i = published - count; i < published; ++i) {
+      if (shm::read_slot(*m_segment, i, samples[valid])) {
+        ++valid;
+      } else {
+        valid = 0;
+      }
+    }
+    samples.resize(valid);
+    return samples;
+  }
+
+  /**
+   * @brief Queues a command for the bus owner.
+   *
+   * @return False if not connected or the queue is full.
+   */
+  bool send(const shm::Command& command) {
+    return m_segment != nullptr && shm::push_command(*m_segment, command);
+  }
+
+ private:
+  shm::Segment* m_segment{nullptr};
+};
+
+}  // namespace robotiq
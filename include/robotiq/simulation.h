@@ -0,0 +1,168 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "robotiq/transport.h"
+#include "robotiq/types.h"
+
+namespace robotiq {
+
+/** Timing of a SimulatedGripper */
+struct SimulatedGripperConfig {
+  std::size_t baud{DEFAULT_BAUD};       /** Sets the time to transmit each byte */
+  uint8_t slave_id{DEFAULT_SLAVE_ID};   /** MODBUS slave id the gripper answers to */
+  uint32_t turnaround_us{1000};         /** Delay between a request and its response */
+  uint32_t activation_time_ms{0};       /** Time from activation request to completion */
+  double full_stroke_time_s{0.6};       /** Time to cover the full stroke at max speed */
+  double min_speed_ratio{20.0 / 150.0}; /** Ratio of the min to the max finger speed */
+};
+
+/**
+ * @brief In-process stand-in for a gripper on the serial bus.  Answers the MODBUS RTU
+ * requests of RobotiqGripperInterface with the timing of a real bus, moves the fingers
+ * towards the requested position, and reports the configured fault.  Requests with an
+ * invalid CRC or another slave id are ignored like on the real gripper.
+ */
+class SimulatedGripper : public Transport {
+ public:
+  explicit SimulatedGripper(const SimulatedGripperConfig& config = {});
+
+  bool write(const std::string& bytes) override;
+  bool read_byte(char& c, std::size_t timeout_ms) override;
+  void flush_input() override;
+
+  /** @brief Reports a fault (gFLT) in the status until cleared with NONE. */
+  void set_fault(FaultStatus fault);
+
+  /**
+   * @brief Places an object the fingers stop on while closing, at a raw position
+   * between 0 (open) and 255 (closed), or removes it with a negative value.  Moving a
+   * held object towards closed or removing it makes the fingers close further, like a
+   * slip or a dropped object.
+   */
+  void set_object(int raw_position);
+
+  /** @brief Returns the raw finger position. */
+  uint8_t raw_position();
+
+  /** @brief Returns the number of requests answered. */
+  std::size_t requests() const { return m_requests; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  void update(Clock::time_point now);
+  std::string respond(const std::string& request, Clock::time_point now);
+  std::string input_registers(Clock::time_point now);
+
+  SimulatedGripperConfig m_config;
+  std::chrono::nanoseconds m_byte_time;
+
+  // Output registers: action request, position request, speed, force
+  uint8_t m_action{0};
+  uint8_t m_position_request{0};
+  uint8_t m_speed{0};
+  uint8_t m_force{0};
+
+  double m_position{0};
+  bool m_moving{false};
+  int m_object{-1};
+  uint8_t m_object_status{0};
+  uint8_t m_fault{0};
+  Clock::time_point m_activation_done;
+  Clock::time_point m_last_update;
+
+  // Response bytes and the time each one is fully received
+  std::deque<std::pair<Clock::time_point, char>> m_pending;
+  std::size_t m_requests{0};
+};
+
+/**
+ * @brief Impairments applied by an ImpairedTransport.  Probabilities are per response
+ * frame, except port loss which is per request.
+ */
+struct ImpairmentProfile {
+  uint32_t seed{0};                     /** Seed of the pseudo-random generator */
+  double drop_byte_probability{0};      /** A random byte of the response is lost */
+  double flip_bit_probability{0};       /** A random bit of the response is flipped */
+  double truncate_probability{0};       /** The response stops after a random byte */
+  double delay_probability{0};          /** The first byte of the response is delayed */
+  uint32_t delay_us{0};                 /** Delay of the first byte when delayed */
+  double fault_probability{0};          /** The status reports the fault below */
+  FaultStatus fault{FaultStatus::NONE}; /** Fault injected in status responses */
+  double port_loss_probability{0};      /** The port disappears before a request */
+  uint32_t port_loss_ms{0};             /** Time until the port comes back */
+};
+
+/** Number of impairments applied by an ImpairedTransport */
+struct ImpairmentCounters {
+  std::size_t frames{0};
+  std::size_t dropped_bytes{0};
+  std::size_t flipped_bits{0};
+  std::size_t truncated{0};
+  std::size_t delayed{0};
+  std::size_t faults{0};
+  std::size_t port_losses{0};
+};
+
+/**
+ * @brief Forwards to another transport, usually a SimulatedGripper or a serial port on
+ * a pty, and impairs the responses as configured by a seedable profile: dropped bytes,
+ * flipped bits, truncated frames, a delayed first byte, injected gripper faults and a
+ * disappearing port.  The same seed and requests give the same impairments.
+ *
+ * Responses are framed from the MODBUS RTU header, so every impairment applies to a
+ * whole response frame before its first byte is returned.
+ */
+class ImpairedTransport : public Transport {
+ public:
+  ImpairedTransport(std::unique_ptr<Transport> transport,
+                    const ImpairmentProfile& profile);
+
+  bool write(const std::string& bytes) override;
+  bool read_byte(char& c, std::size_t timeout_ms) override;
+  void flush_input() override;
+
+  /** @brief Returns the impairments applied so far. */
+  const ImpairmentCounters& counters() const { return m_counters; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  bool chance(double probability);
+  void receive_frame(std::size_t timeout_ms);
+  void impair(std::string& frame);
+
+  std::unique_ptr<Transport> m_transport;
+  ImpairmentProfile m_profile;
+  std::mt19937 m_random;
+  ImpairmentCounters m_counters;
+
+  bool m_awaiting_response{false};
+  bool m_status_request{false};
+  std::string m_frame;
+  std::size_t m_next{0};
+  Clock::time_point m_ready;
+  Clock::time_point m_port_back;
+};
+
+}  // namespace robotiq
@@ -0,0 +1,151 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace robotiq {
+
+/*
+ * Telemetry log format (version 1), all fields little endian:
+ *
+ *   TelemetryFileHeader, padded to TELEMETRY_HEADER_SIZE bytes
+ *   Block 0, Block 1, ...  each TELEMETRY_BLOCK_SIZE bytes
+ *
+ * Every block starts with a TelemetryBlockHeader that indexes the block by time,
+ * followed by up to TELEMETRY_RECORDS_PER_BLOCK fixed-size records whose timestamps are
+ * offsets from the block base time.  A block is only left partially filled when the next
+ * record would overflow its offsets, or when it is the last block.  Since the blocks
+ * have a fixed size, a reader seeks by time with a binary search over the block headers
+ * without parsing the records.
+ */
+
+/** Identifies a telemetry log ("RGTL") */
+const uint32_t TELEMETRY_MAGIC = 0x4C544752;
+
+/** Identifies a block header ("BLK0") */
+const uint32_t TELEMETRY_BLOCK_MAGIC = 0x304B4C42;
+
+/** Version of the log format */
+const uint32_t TELEMETRY_VERSION = 1;
+
+/** Size of the file header, a page so that the blocks can be mapped */
+const std::size_t TELEMETRY_HEADER_SIZE = 4096;
+
+/** Size of a block, including its header */
+const std::size_t TELEMETRY_BLOCK_SIZE = 65536;
+
+/** Kinds of telemetry records */
+enum TelemetryRecordType : uint8_t {
+  RECORD_FEEDBACK, /** Registers are the three gripper input registers */
+  RECORD_COMMAND,  /** Registers are the three gripper output registers */
+};
+
+/** Set in TelemetrySample::flags if a valid response was received */
+const uint8_t RECORD_RESPONSE_VALID = 0x01;
+
+#pragma pack(push, 1)
+
+/** Header at the start of a telemetry log */
+struct TelemetryFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t block_size;
+  uint32_t record_size;
+  int64_t start_steady_ns; /** std::chrono::steady_clock time the log was opened */
+  int64_t start_system_ns; /** std::chrono::system_clock time the log was opened */
+};
+
+/** Header at the start of every block */
+struct TelemetryBlockHeader {
+  uint32_t magic;
+  uint32_t count;  /** Number of records written to the block */
+  int64_t base_ns; /** steady_clock time of the first record in the block */
+};
+
+/** Record stored in a block, 16 bytes */
+struct TelemetryRecord {
+  uint32_t offset_us;   /** Time since the block base time */
+  uint16_t latency_us;  /** Time between request and response, saturated */
+  uint8_t type;         /** TelemetryRecordType */
+  uint8_t flags;        /** See RECORD_RESPONSE_VALID */
+  uint8_t registers[6]; /** Raw register bytes as transmitted */
+  uint8_t reserved[2];
+};
+
+#pragma pack(pop)
+
+/** Number of records in a block */
+const std::size_t TELEMETRY_RECORDS_PER_BLOCK =
+    (TELEMETRY_BLOCK_SIZE - sizeof(TelemetryBlockHeader)) / sizeof(TelemetryRecord);
+
+/** A telemetry sample, as recorded and as returned by the reader */
+struct TelemetrySample {
+  int64_t stamp_ns{0};    /** steady_clock time the transaction completed */
+  uint32_t latency_us{0}; /** Time between request and response */
+  uint8_t type{RECORD_FEEDBACK};
+  uint8_t flags{0};
+  uint8_t registers[6]{};
+};
+
+/**
+ * @brief Reads a telemetry log written by RobotiqGripperInterface::record_telemetry.
+ * The file is memory mapped, so random access and seeking by time do not parse it.
+ */
+class TelemetryReader {
+ public:
+  TelemetryReader() = default;
+  TelemetryReader(const TelemetryReader&) = delete;
+  TelemetryReader& operator=(const TelemetryReader&) = delete;
+  ~TelemetryReader();
+
+  /**
+   * @brief Maps a telemetry log.
+   *
+   * @return True if the file is a valid log of a supported version.
+   */
+  bool open(const std::string& path);
+
+  /** @brief Unmaps the log. */
+  void close();
+
+  /** @brief Returns the file header, valid while open. */
+  const TelemetryFileHeader& header() const;
+
+  /** @brief Returns the number of records. */
+  std::size_t size() const { return m_size; }
+
+  /** @brief Returns the record at the given index, which must be less than size(). */
+  TelemetrySample at(std::size_t index) const;
+
+  /**
+   * @brief Returns the index of the first record at or after a steady_clock time, or
+   * size() if there is none.
+   */
+  std::size_t seek(int64_t stamp_ns) const;
+
+ private:
+  const TelemetryBlockHeader& block(std::size_t index) const;
+
+  const uint8_t* m_data{nullptr};
+  std::size_t m_length{0};
+  std::vector<std::size_t> m_block_starts;  // Index of the first record of each block
+  std::size_t m_size{0};
+};
+
+}  // namespace robotiq
@@ -0,0 +1,197 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "robotiq/constants.h"
+
+namespace robotiq {
+
+/**
+ * @brief Byte stream between RobotiqGripperInterface and the gripper.  The default
+ * transport is the serial port opened by RobotiqGripperInterface::connect, other
+ * transports are passed to the connect overload taking a transport.
+ */
+class Transport {
+ public:
+  virtual ~Transport() = default;
+
+  /** @brief Writes the bytes, returns false on error. */
+  virtual bool write(const std::string& bytes) = 0;
+
+  /** @brief Reads one byte, returns false if none arrived within the timeout. */
+  virtual bool read_byte(char& c, std::size_t timeout_ms) = 0;
+
+  /** @brief Discards bytes that were received but not read. */
+  virtual void flush_input() = 0;
+};
+
+/** Opt-in settings of a serial port, see SerialTransport::open */
+struct SerialOptions {
+  bool low_latency{false}; /** Applies the low-latency settings below */
+  bool rs485{true};        /** In low-latency mode, enables kernel RS-485 if supported */
+};
+
+/**
+ * Low-latency settings that took effect when a serial port was opened.  Settings the
+ * driver does not support, e.g. on a pty or a USB adapter without RS-485 control, are
+ * skipped and stay false.
+ */
+struct SerialLatencyReport {
+  bool raw_termios{false}; /** Raw mode with VMIN 1 and VTIME 0, so bytes are not held */
+  bool low_latency{false}; /** ASYNC_LOW_LATENCY, e.g. a 1 ms FTDI latency timer */
+  bool rs485{false};       /** Kernel RS-485 mode (TIOCSRS485) drives the transceiver */
+  bool flushed{false};     /** Stale input and output were discarded */
+};
+
+/** Describes a report as "raw_termios=yes low_latency=no rs485=no flushed=yes" */
+std::string to_string(const SerialLatencyReport& report);
+
+/**
+ * @brief Serial port transport for MODBUS RTU over RS-485.
+ */
+class SerialTransport : public Transport {
+ public:
+  SerialTransport();
+  SerialTransport(const SerialTransport&) = delete;
+  SerialTransport& operator=(const SerialTransport&) = delete;
+  ~SerialTransport() override;
+
+  /**
+   * @brief Opens the port with 8 data bits, 1 stop bit and no parity.  With
+   * options.low_latency, the port is also switched to raw termios, the driver is asked
+   * to deliver bytes without buffering delay, kernel RS-485 mode is enabled where the
+   * driver supports it, and both directions are flushed.  Unsupported settings do not
+   * fail the open, see latency_report().
+   *
+   * @param[in] port  Serial port for communication (Ubuntu default: /dev/ttyUSB0)
+   * @param[in] baud  Baud rate (default: 115200)
+   * @param[out] error  Error message if the port could not be opened
+   * @param[in] options  Opt-in settings
+   * @return True if succeeded.
+   */
+  bool open(const std::string& port, std::size_t baud, std::string& error,
+            const SerialOptions& options = {});
+
+  /** @brief Returns the low-latency settings that took effect at the last open. */
+  const SerialLatencyReport& latency_report() const;
+
+  bool write(const std::string& bytes) override;
+  bool read_byte(char& c, std::size_t timeout_ms) override;
+  void flush_input() override;
+
+ private:
+  // Pointer to implementation idiom is used to hide asio from consumers
+  struct Implementation;
+  std::unique_ptr<Implementation> m_impl;
+};
+
+/** Kinds of events in a wire capture */
+enum WireEventType : uint8_t {
+  WIRE_WRITE,        /** Bytes written to the gripper */
+  WIRE_READ,         /** One byte read from the gripper */
+  WIRE_READ_TIMEOUT, /** A read that timed out */
+};
+
+/** An event of a wire capture */
+struct WireEvent {
+  int64_t offset_ns{0}; /** Time since the start of the capture */
+  WireEventType type{WIRE_WRITE};
+  std::string bytes;
+};
+
+/**
+ * @brief Forwards to another transport and records the exact bytes and timing of every
+ * write and read to a capture file, for offline reproduction with ReplayTransport.
+ *
+ * Capture file format: the magic "RGWC", a uint32 version, then one event per write, read
+ * byte or read timeout: int64 offset_ns, uint8 type, uint16 length, then length bytes.
+ */
+class CaptureTransport : public Transport {
+ public:
+  /**
+   * @param[in] transport  Transport to capture, usually a SerialTransport
+   */
+  explicit CaptureTransport(std::unique_ptr<Transport> transport);
+
+  /**
+   * @brief Creates the capture file, truncating any existing file.
+   *
+   * @return True if succeeded.
+   */
+  bool open(const std::string& path);
+
+  bool write(const std::string& bytes) override;
+  bool read_byte(char& c, std::size_t timeout_ms) override;
+  void flush_input() override;
+
+ private:
+  void record(WireEventType type, const std::string& bytes);
+
+  std::unique_ptr<Transport> m_transport;
+  std::ofstream m_file;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * @brief Feeds a wire capture back to RobotiqGripperInterface.  Every write consumes the
+ * next captured write, and the captured responses are returned with their original
+ * timing relative to that write, divided by the speedup factor.  A speedup of zero
+ * returns the responses as fast as possible, for deterministic benchmarks.
+ */
+class ReplayTransport : public Transport {
+ public:
+  ReplayTransport() = default;
+
+  /**
+   * @brief Loads a capture file written by CaptureTransport.
+   *
+   * @param[in] path  Capture file
+   * @param[in] speedup  Timing acceleration, 1 for the original timing, 0 for none
+   * @return True if succeeded.
+   */
+  bool open(const std::string& path, double speedup = 1.0);
+
+  /** @brief Loads captured events directly, e.g. from a test. */
+  void load(const std::vector<WireEvent>& events, double speedup = 1.0);
+
+  bool write(const std::string& bytes) override;
+  bool read_byte(char& c, std::size_t timeout_ms) override;
+  void flush_input() override;
+
+  /** @brief Returns the number of writes that differed from the capture. */
+  std::size_t mismatches() const { return m_mismatches; }
+
+  /** @brief Returns true once every captured event was replayed. */
+  bool finished() const { return m_next >= m_events.size(); }
+
+ private:
+  void wait_until(int64_t offset_ns) const;
+
+  std::vector<WireEvent> m_events;
+  std::size_t m_next{0};
+  double m_speedup{1};
+  std::size_t m_mismatches{0};
+  int64_t m_write_offset_ns{0};
+  std::chrono::steady_clock::time_point m_write_time;
+};
+
+}  // namespace robotiq
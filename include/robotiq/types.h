@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "robotiq/constants.h"
 
 namespace robotiq {
@@ -84,6 +86,19 @@ struct DetailedStatus {
   FaultStatus gflt;
 };
 
+/**
+ * Monotonic (std::chrono::steady_clock) times of a feedback transaction.  The gripper
+ * samples its registers between the end of the request and the start of the response,
+ * so sampled is the middle of that interval, computed from the baud rate.  Latencies of
+ * the serial adapter are the same both ways and cancel out of the estimate.
+ */
+struct FeedbackTiming {
+  std::chrono::steady_clock::time_point sent;       /** Request written */
+  std::chrono::steady_clock::time_point first_byte; /** First response byte read */
+  std::chrono::steady_clock::time_point completed;  /** Response frame complete */
+  std::chrono::steady_clock::time_point sampled;    /** Estimated gripper sample time */
+};
+
 /** Holds the gripper feedback */
 struct GripperFeedback {
   double commanded_position{0};      /** Range determined by alpha, beta */
@@ -92,6 +107,39 @@ struct GripperFeedback {
   uint8_t raw_commanded_position{0}; /** Between 0 (open) and 255 (closed) */
   uint8_t raw_position{0};           /** Between 0 (open) and 255 (closed) */
   DetailedStatus status;             /** Detailed status returned by the gripper*/
+  FeedbackTiming timing;             /** Times of the transaction */
+};
+
+/** Position, speed, and force target of a gripper in a group command */
+struct GripperTarget {
+  double position{0}; /** Range determined by alpha, beta */
+  double speed{1};    /** Between 0 (min) and 1 (max) */
+  double force{1};    /** Between 0 (min) and 1 (max) */
+};
+
+/** Speed and force profile of a grasp, see RobotiqGripperInterface::grasp */
+struct GraspProfile {
+  double expected_width{0};   /** Expected object width, scaled by alpha, beta */
+  double slowdown_margin{0};  /** Distance from the object to slow down, scaled */
+  double approach_speed{1};   /** Between 0 (min) and 1 (max) */
+  double approach_force{1};   /** Between 0 (min) and 1 (max) */
+  double contact_speed{0.1};  /** Between 0 (min) and 1 (max) */
+  double contact_force{0.2};  /** Between 0 (min) and 1 (max) */
+};
+
+/** Timing and kinematics of a gripper model, see robotiq/gripper_models.h */
+struct ModelParameters {
+  std::size_t activation_settle_ms{2000}; /** Wait after gACT rises before moving */
+  double full_stroke_time_s{0.6};         /** Time to cover the stroke at max speed */
+  double min_speed_ratio{20.0 / 150.0};   /** Ratio of the min to the max finger speed */
+};
+
+/** Bus transactions of a gripper, see RobotiqGripperInterface::set_cache_freshness */
+struct RegisterCacheStats {
+  uint64_t transactions{0};   /** Requests sent on the bus */
+  uint64_t skipped_writes{0}; /** Position commands equal to the confirmed state */
+  uint64_t cached_reads{0};   /** Status queries answered by the shadow registers */
+  uint64_t merged_reads{0};   /** Queued reads merged into the transaction of another */
 };
 
 }  // namespace robotiq
@@ -0,0 +1,135 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/calibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace robotiq {
+
+// Identifies a calibration file ("RGCL") and its format version
+static const char CALIBRATION_MAGIC[4] = {'R', 'G', 'C', 'L'};
+static const uint32_t CALIBRATION_VERSION = 1;
+
+bool Calibration::build(std::vector<CalibrationPoint> points) {
+  std::sort(points.begin(), points.end(),
+            [](const CalibrationPoint& a, const CalibrationPoint& b) {
+              return a.word < b.word;
+            });
+  if (points.size() < 2) {
+    return false;
+  }
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    if (points[i].word == points[i - 1].word) {
+      return false;
+    }
+  }
+
+  // Interpolate within the segments and extrapolate the first and last ones
+  std::size_t segment = 0;
+  for (std::size_t word = 0; word < m_forward.size(); ++word) {
+    while (segment + 2 < points.size() && word > points[segment + 1].word) {
+      ++segment;
+    }
+    const CalibrationPoint& a = points[segment];
+    const CalibrationPoint& b = points[segment + 1];
+    double slope = (b.position - a.position) / (b.word - a.word);
+    m_forward[word] = a.position + slope * (static_cast<double>(word) - a.word);
+  }
+  return build_inverse();
+}
+
+bool Calibration::save(const std::string& path) const {
+  if (not m_valid) {
+    return false;
+  }
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(CALIBRATION_MAGIC, sizeof(CALIBRATION_MAGIC));
+  file.write(reinterpret_cast<const char*>(&CALIBRATION_VERSION),
+             sizeof(CALIBRATION_VERSION));
+  file.write(reinterpret_cast<const char*>(m_forward.data()),
+             m_forward.size() * sizeof(double));
+  return static_cast<bool>(file);
+}
+
+bool Calibration::load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[4];
+  uint32_t version = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (not file || not std::equal(magic, magic + 4, CALIBRATION_MAGIC) ||
+      version != CALIBRATION_VERSION) {
+    return false;
+  }
+  std::array<double, 256> forward;
+  file.read(reinterpret_cast<char*>(forward.data()), forward.size() * sizeof(double));
+  if (not file) {
+    return false;
+  }
+  m_forward = forward;
+  return build_inverse();
+}
+
+uint8_t Calibration::to_word(double position) const {
+  double scaled = (position - m_inverse_origin) * m_inverse_scale;
+  std::size_t bin = static_cast<std::size_t>(std::min(std::max(scaled, 0.0), 255.0));
+
+  // The first word past the position is at most the first word of the next bin, so
+  // only the words of this bin are bisected, in at most eight steps
+  std::size_t low = m_inverse[bin];
+  std::size_t high = bin < 255 ? m_inverse[bin + 1] : 255;
+  while (low < high) {
+    std::size_t middle = (low + high) / 2;
+    if ((m_forward[middle] - position) * m_inverse_scale > 0) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+
+  // The nearest word is the first word past the position or the one before it
+  std::size_t word = low;
+  if (word > 0 &&
+      std::abs(m_forward[word - 1] - position) < std::abs(m_forward[word] - position)) {
+    --word;
+  }
+  return static_cast<uint8_t>(word);
+}
+
+bool Calibration::build_inverse() {
+  m_valid = false;
+  double direction = m_forward[255] > m_forward[0] ? 1 : -1;
+  for (std::size_t word = 1; word < m_forward.size(); ++word) {
+    if (not((m_forward[word] - m_forward[word - 1]) * direction > 0)) {
+      return false;
+    }
+  }
+
+  m_inverse_origin = m_forward[0];
+  m_inverse_scale = 255.0 / (m_forward[255] - m_forward[0]);
+  std::size_t word = 0;
+  for (std::size_t bin = 0; bin < m_inverse.size(); ++bin) {
+    while (word < 255 && (m_forward[word] - m_inverse_origin) * m_inverse_scale < bin) {
+      ++word;
+    }
+    m_inverse[bin] = static_cast<uint8_t>(word);
+  }
+  m_valid = true;
+  return true;
+}
+
+}  // namespace robotiq
@@ -0,0 +1,92 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/discovery.h"
+
+#include <functional>
+#include <thread>
+
+namespace robotiq {
+
+// Probes a port and activates the gripper that answered
+static void discover_port(const DiscoveryOptions& options, DiscoveredGripper& result) {
+  std::unique_ptr<Transport> transport;
+  if (options.open_transport) {
+    transport = options.open_transport(result.port);
+  } else {
+    auto serial = std::make_unique<SerialTransport>();
+    std::string error;
+    if (serial->open(result.port, options.baud, error, options.serial)) {
+      transport = std::move(serial);
+    }
+  }
+  if (transport == nullptr) {
+    result.error = ErrorCode::PORT_ERROR;
+    return;
+  }
+
+  std::unique_ptr<RobotiqGripperInterface> gripper;
+  if (options.connect_gripper) {
+    gripper = options.connect_gripper(std::move(transport));
+  } else {
+    gripper = std::make_unique<RobotiqGripperInterface>();
+    gripper->connect(std::move(transport));
+  }
+  if (gripper == nullptr) {
+    result.error = ErrorCode::PORT_ERROR;
+    return;
+  }
+
+  // Absent slave ids never answer, so each costs one short timeout
+  gripper->set_timeout(options.probe_timeout_ms);
+  Result<GripperFeedback> y = ErrorCode::INVALID_ARGUMENT;
+  for (uint8_t slave_id : options.slave_ids) {
+    gripper->set_slave_id(slave_id);
+    y = gripper->get_feedback();
+    if (y || y.error() == ErrorCode::NOT_CONNECTED) {
+      break;
+    }
+  }
+  if (not y) {
+    result.error = y.error();
+    return;
+  }
+  gripper->set_timeout(options.timeout_ms);
+  result.slave_id = gripper->get_slave_id();
+  result.status = y->status;
+
+  if (options.activate && y->status.gact == ActivationStatus::NOT_ACTIVATED) {
+    Result<void> activated = gripper->activate(true);
+    result.activated = activated.has_value();
+    result.error = activated.error();
+  }
+  result.gripper = std::move(gripper);
+}
+
+std::vector<DiscoveredGripper> discover_grippers(const std::vector<std::string>& ports,
+                                                 const DiscoveryOptions& options) {
+  std::vector<DiscoveredGripper> results(ports.size());
+  std::vector<std::thread> threads;
+  threads.reserve(ports.size());
+  for (std::size_t i = 0; i < ports.size(); ++i) {
+    results[i].port = ports[i];
+    threads.emplace_back(discover_port, std::cref(options), std::ref(results[i]));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+}  // namespace robotiq
@@ -0,0 +1,127 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/feedback_ring.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robotiq {
+
+// Returns the nanoseconds of a steady clock time since the clock epoch
+static int64_t to_ns(FeedbackRing::Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch())
+      .count();
+}
+
+void FeedbackRing::push(const GripperFeedback& feedback) {
+  uint8_t current = static_cast<uint8_t>(std::lround(feedback.current * 255.0));
+  uint8_t status = pack_status(feedback.status);
+  int64_t stamp = to_ns(feedback.timing.sampled);
+  for (std::size_t i : {m_next, m_next + FEEDBACK_RING_CAPACITY}) {
+    m_raw_position[i] = feedback.raw_position;
+    m_raw_commanded_position[i] = feedback.raw_commanded_position;
+    m_raw_current[i] = current;
+    m_status[i] = status;
+    m_stamp_ns[i] = stamp;
+  }
+  m_next = (m_next + 1) % FEEDBACK_RING_CAPACITY;
+  m_size = std::min(m_size + 1, FEEDBACK_RING_CAPACITY);
+}
+
+FeedbackSpans FeedbackRing::last(std::size_t count) const {
+  count = std::min(count, m_size);
+  return spans(m_size - count, count);
+}
+
+FeedbackSpans FeedbackRing::window(Clock::time_point from, Clock::time_point to) const {
+  FeedbackSpans all = spans(0, m_size);
+  const int64_t* end = all.stamp_ns + all.size;
+  const int64_t* first = std::lower_bound(all.stamp_ns, end, to_ns(from));
+  const int64_t* stop = std::upper_bound(first, end, to_ns(to));
+  return spans(static_cast<std::size_t>(first - all.stamp_ns),
+               static_cast<std::size_t>(stop - first));
+}
+
+bool FeedbackRing::word_at(Clock::time_point time, double& word) const {
+  FeedbackSpans all = spans(0, m_size);
+  if (all.size == 0) {
+    return false;
+  }
+
+  // Interpolate between the samples around the time, the oldest one holds before it
+  int64_t stamp = to_ns(time);
+  const int64_t* end = all.stamp_ns + all.size;
+  std::size_t after = static_cast<std::size_t>(
+      std::lower_bound(all.stamp_ns, end, stamp) - all.stamp_ns);
+  if (after == 0) {
+    word = all.raw_position[0];
+    return true;
+  }
+  if (after < all.size) {
+    std::size_t before = after - 1;
+    double span = static_cast<double>(all.stamp_ns[after] - all.stamp_ns[before]);
+    double ratio = static_cast<double>(stamp - all.stamp_ns[before]) / span;
+    word = all.raw_position[before] +
+           ratio * (all.raw_position[after] - all.raw_position[before]);
+    return true;
+  }
+
+  // Extrapolate the motion toward the commanded position, stopped fingers stay put
+  std::size_t newest = all.size - 1;
+  word = all.raw_position[newest];
+  bool in_motion = unpack_status(all.status[newest]).gobj == ObjectStatus::IN_MOTION;
+  if (all.size < 2 || not in_motion ||
+      all.stamp_ns[newest] <= all.stamp_ns[newest - 1]) {
+    return true;
+  }
+  double velocity = (all.raw_position[newest] - all.raw_position[newest - 1]) /
+                    static_cast<double>(all.stamp_ns[newest] - all.stamp_ns[newest - 1]);
+  double remaining = all.raw_commanded_position[newest] - word;
+  if (velocity * remaining > 0) {
+    double travel = velocity * static_cast<double>(stamp - all.stamp_ns[newest]);
+    word += remaining > 0 ? std::min(travel, remaining) : std::max(travel, remaining);
+  }
+  return true;
+}
+
+FeedbackSpans FeedbackRing::spans(std::size_t i, std::size_t count) const {
+  // The oldest sample is m_size slots before the next one, in the upper copy
+  std::size_t start = m_next + FEEDBACK_RING_CAPACITY - m_size + i;
+  FeedbackSpans spans;
+  spans.size = count;
+  spans.raw_position = m_raw_position.data() + start;
+  spans.raw_commanded_position = m_raw_commanded_position.data() + start;
+  spans.raw_current = m_raw_current.data() + start;
+  spans.status = m_status.data() + start;
+  spans.stamp_ns = m_stamp_ns.data() + start;
+  return spans;
+}
+
+uint8_t FeedbackRing::pack_status(const DetailedStatus& status) {
+  return static_cast<uint8_t>((status.gobj & 0x03) << 6 | (status.gsta & 0x03) << 4 |
+                              (status.ggto & 0x01) << 3 | (status.gact & 0x01));
+}
+
+DetailedStatus FeedbackRing::unpack_status(uint8_t status) {
+  DetailedStatus unpacked;
+  unpacked.gobj = static_cast<ObjectStatus>((status & 0xC0) >> 6);
+  unpacked.gsta = static_cast<FingerStatus>((status & 0x30) >> 4);
+  unpacked.ggto = static_cast<ActionStatus>((status & 0x08) >> 3);
+  unpacked.gact = static_cast<ActivationStatus>(status & 0x01);
+  unpacked.gflt = FaultStatus::NONE;
+  return unpacked;
+}
+
+}  // namespace robotiq
@@ -0,0 +1,135 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/grasp_monitor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robotiq {
+
+MovingStatistics::MovingStatistics(std::size_t window)
+    : m_window(std::min(std::max(window, std::size_t{1}), GRASP_MONITOR_MAX_WINDOW)) {}
+
+void MovingStatistics::push(double value) {
+  if (m_size == m_window) {
+    double oldest = m_values[m_next];
+    m_sum -= oldest;
+    m_sum_squares -= oldest * oldest;
+  } else {
+    ++m_size;
+  }
+  m_values[m_next] = value;
+  m_next = (m_next + 1) % m_window;
+  m_sum += value;
+  m_sum_squares += value * value;
+}
+
+void MovingStatistics::clear() {
+  m_size = 0;
+  m_next = 0;
+  m_sum = 0;
+  m_sum_squares = 0;
+}
+
+double MovingStatistics::mean() const { return m_size > 0 ? m_sum / m_size : 0; }
+
+double MovingStatistics::stddev() const {
+  if (m_size < 2) {
+    return 0;
+  }
+  // The running sums cancel to slightly negative variances on constant samples
+  double mean = m_sum / m_size;
+  return std::sqrt(std::max(m_sum_squares / m_size - mean * mean, 0.0));
+}
+
+GraspMonitor::GraspMonitor(const GraspMonitorConfig& config)
+    : m_config(config),
+      m_free_current(config.window),
+      m_holding_current(config.window),
+      m_holding_position(config.window) {}
+
+GraspEvent GraspMonitor::update(const GripperFeedback& feedback) {
+  const GripperFeedback& y = feedback;
+  if (not m_in_contact) {
+    bool closing = y.status.gobj == ObjectStatus::IN_MOTION &&
+                   y.raw_commanded_position > y.raw_position;
+    double rise = m_config.contact_sigma * m_free_current.stddev();
+    double threshold = std::max(m_config.contact_current, m_free_current.mean() + rise);
+    if (y.status.gobj == ObjectStatus::STOPPED_WHILE_CLOSING ||
+        (closing && y.current >= threshold)) {
+      m_in_contact = true;
+      m_contact_command = y.raw_commanded_position;
+      m_holding_current.clear();
+      m_holding_position.clear();
+      m_holding_current.push(y.current);
+      // Fingers still squeezing the object hold from where they stop
+      if (y.status.gobj != ObjectStatus::IN_MOTION) {
+        m_holding_position.push(y.raw_position);
+      }
+      return GraspEvent::CONTACT;
+    }
+    if (closing) {
+      m_free_current.push(y.current);
+    }
+    return GraspEvent::NONE;
+  }
+
+  if (y.raw_commanded_position != m_contact_command) {
+    release();
+    return GraspEvent::NONE;
+  }
+  if (y.status.gobj == ObjectStatus::AT_REQUESTED_POSITION ||
+      y.raw_position >= y.raw_commanded_position) {
+    release();
+    return GraspEvent::OBJECT_LOST;
+  }
+  if (not m_slipping && m_holding_position.size() > 0 &&
+      y.raw_position - m_holding_position.mean() >= m_config.slip_words) {
+    m_slipping = true;
+    return GraspEvent::SLIP;
+  }
+
+  // The current is low while the fingers follow a slipping object, so it only tells an
+  // object loss once they stopped again
+  if (y.status.gobj == ObjectStatus::IN_MOTION) {
+    return GraspEvent::NONE;
+  }
+  if (m_slipping) {
+    // Hold again from where the fingers stopped
+    m_slipping = false;
+    m_holding_position.clear();
+  }
+  if (y.current < m_config.lost_current_ratio * m_holding_current.mean()) {
+    release();
+    return GraspEvent::OBJECT_LOST;
+  }
+  m_holding_current.push(y.current);
+  m_holding_position.push(y.raw_position);
+  return GraspEvent::NONE;
+}
+
+void GraspMonitor::reset() {
+  release();
+  m_free_current.clear();
+}
+
+void GraspMonitor::release() {
+  m_in_contact = false;
+  m_slipping = false;
+  m_holding_current.clear();
+  m_holding_position.clear();
+}
+
+}  // namespace robotiq
@@ -0,0 +1,125 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/gripper_group.h"
+#include "src/helpers.h"
+
+namespace robotiq {
+
+GripperGroup::GripperGroup(const std::vector<RobotiqGripperInterface*>& grippers)
+    : m_grippers(grippers), m_commanded(grippers.size(), 0) {}
+
+Result<void> GripperGroup::set_gripper_positions(
+    const std::vector<GripperTarget>& targets) {
+  if (targets.size() != m_grippers.size()) {
+    return ErrorCode::INVALID_ARGUMENT;
+  }
+
+  // Compute every word before writing so nothing delays the writes
+  struct Words {
+    uint8_t position, speed, force;
+  };
+  std::vector<Words> words(targets.size());
+  for (std::size_t i = 0; i < targets.size(); ++i) {
+    words[i] = {m_grippers[i]->position_to_word(targets[i].position),
+                ratio_to_word(targets[i].speed), ratio_to_word(targets[i].force)};
+    m_commanded[i] = words[i].position;
+  }
+
+  // Write the commands back to back, then collect the acknowledgements
+  using Clock = std::chrono::steady_clock;
+  std::vector<Result<void>> sent;
+  sent.reserve(m_grippers.size());
+  Clock::time_point first_write, last_write;
+  for (std::size_t i = 0; i < m_grippers.size(); ++i) {
+    sent.push_back(m_grippers[i]->send_raw_position_command(
+        words[i].position, words[i].speed, words[i].force));
+    last_write = Clock::now();
+    if (i == 0) {
+      first_write = last_write;
+    }
+  }
+  m_start_skew = std::chrono::duration_cast<std::chrono::microseconds>(last_write -
+                                                                       first_write);
+
+  // Only grippers whose command was written have a response to collect
+  Result<void> result;
+  for (std::size_t i = 0; i < m_grippers.size(); ++i) {
+    if (sent[i]) {
+      sent[i] = m_grippers[i]->receive_preset_response();
+    }
+    if (result && not sent[i]) {
+      result = sent[i];
+    }
+  }
+  return result;
+}
+
+std::chrono::microseconds GripperGroup::get_start_skew() const { return m_start_skew; }
+
+Result<void> GripperGroup::wait_for_all(std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  std::vector<bool> done(m_grippers.size(), false);
+  std::size_t remaining = m_grippers.size();
+  while (remaining > 0) {
+    for (std::size_t i = 0; i < m_grippers.size(); ++i) {
+      if (done[i]) {
+        continue;
+      }
+      Result<bool> y = is_done(i);
+      if (not y.has_value()) {
+        return y.error();
+      }
+      if (*y) {
+        done[i] = true;
+        --remaining;
+      }
+    }
+    if (remaining > 0 && std::chrono::steady_clock::now() > deadline) {
+      return ErrorCode::MOTION_TIMEOUT;
+    }
+  }
+  return {};
+}
+
+Result<int> GripperGroup::wait_for_any(std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (not m_grippers.empty()) {
+    for (std::size_t i = 0; i < m_grippers.size(); ++i) {
+      Result<bool> y = is_done(i);
+      if (not y.has_value()) {
+        return y.error();
+      }
+      if (*y) {
+        return static_cast<int>(i);
+      }
+    }
+    if (std::chrono::steady_clock::now() > deadline) {
+      break;
+    }
+  }
+  return ErrorCode::MOTION_TIMEOUT;
+}
+
+Result<bool> GripperGroup::is_done(std::size_t index) {
+  // The commanded position echo guards against a status read before the command applied
+  Result<GripperFeedback> y = m_grippers[index]->get_feedback();
+  if (not y) {
+    return y.error();
+  }
+  return y->status.gobj != ObjectStatus::IN_MOTION &&
+         y->raw_commanded_position == m_commanded[index];
+}
+
+}  // namespace robotiq
@@ -12,33 +12,39 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <arpa/inet.h>
 
 #include <boost/crc.hpp>
 
 #include "src/helpers.h"
-#include "src/timeout_reader.h"
 
 namespace robotiq {
 
-std::string write_read(boost::asio::serial_port& serial, const std::string& message,
-                       std::size_t timeout_ms) {
-  // write
-  write(serial, message);
-
-  // read
-  TimeoutReader reader(serial, timeout_ms);
+std::string read(Transport& transport, std::size_t timeout_ms, std::size_t expected_bytes,
+                 std::chrono::steady_clock::time_point* first_byte) {
   char c;
   std::string result;
-  while (reader.read_char(c) && c != '\n') {
+  while (result.size() < expected_bytes && transport.read_byte(c, timeout_ms)) {
+    if (result.empty() && first_byte) {
+      *first_byte = std::chrono::steady_clock::now();
+    }
     result += c;
+    // A modbus exception response is 5 bytes, so stop there instead of timing out
+    if (result.size() == 5 && (result[1] & 0x80)) {
+      break;
+    }
   }
   return bin_to_hex(result);
 }
 
-void write(boost::asio::serial_port& serial, const std::string& message) {
-  std::string binary_msg = hex_to_bin(message);
-  asio::write(serial, asio::buffer(binary_msg.c_str(), binary_msg.size()));
+bool write(Transport& transport, const std::string& message) {
+  return transport.write(hex_to_bin(message));
 }
 
 std::string bin_to_hex(const std::string& input) {
@@ -54,7 +60,7 @@ std::string bin_to_hex(const std::string& input) {
 
 std::string hex_to_bin(const std::string& input) {
   std::string bin_string;
-  for (std::size_t i = 0; i < input.length() - 1; i += 2) {
+  for (std::size_t i = 0; i + 1 < input.length(); i += 2) {
     bin_string += (input[i] >= 'A' ? input[i] - 'A' + 10 : input[i] - '0') * 16 +
                   (input[i + 1] >= 'A' ? input[i + 1] - 'A' + 10 : input[i + 1] - '0');
   }
@@ -69,6 +75,90 @@ std::string uint8_to_hex(uint8_t value) {
   return str;
 }
 
+std::string uint16_to_hex(uint16_t value) {
+  return uint8_to_hex(static_cast<uint8_t>(value >> 8)) +
+         uint8_to_hex(static_cast<uint8_t>(value & 0xFF));
+}
+
+uint16_t hex_to_uint16(const std::string& input) {
+  std::string bin = hex_to_bin(input);
+  if (bin.size() != 2) {
+    return 0;
+  }
+  return static_cast<uint16_t>((static_cast<unsigned char>(bin[0]) << 8) |
+                               static_cast<unsigned char>(bin[1]));
+}
+
+bool has_valid_crc(const std::string& input) {
+  if (input.size() < 8 || input.size() % 2 != 0) {
+    return false;
+  }
+  std::size_t body = input.size() - 4;
+  return crc16_modbus(input.substr(0, body)) == input.substr(body);
+}
+
+FaultStatus code_to_fault(uint8_t code) {
+  switch (code) {
+    case 0:
+      return FaultStatus::NONE;
+    case 5:
+      return FaultStatus::ACTION_DELAYED;
+    case 7:
+      return FaultStatus::ACTIVATION_NEEDED;
+    case 8:
+      return FaultStatus::MAX_TEMP_EXCEEDED;
+    case 9:
+      return FaultStatus::COMM_TIMEOUT;
+    case 10:
+      return FaultStatus::UNDER_VOLTAGE;
+    case 11:
+      return FaultStatus::AUTOMATIC_RELEASE_IN_PROGRESS;
+    case 12:
+      return FaultStatus::INTERNAL_FAULT;
+    case 13:
+      return FaultStatus::ACTIVATION_FAULT;
+    case 14:
+      return FaultStatus::OVERCURRENT;
+    case 15:
+      return FaultStatus::AUTOMATIC_RELEASE_COMPLETED;
+    default:
+      return FaultStatus::UNKNOWN;
+  }
+}
+
+uint8_t fault_to_code(FaultStatus fault) {
+  switch (fault) {
+    case FaultStatus::NONE:
+      return 0;
+    case FaultStatus::ACTION_DELAYED:
+      return 5;
+    case FaultStatus::ACTIVATION_NEEDED:
+      return 7;
+    case FaultStatus::MAX_TEMP_EXCEEDED:
+      return 8;
+    case FaultStatus::COMM_TIMEOUT:
+      return 9;
+    case FaultStatus::UNDER_VOLTAGE:
+      return 10;
+    case FaultStatus::AUTOMATIC_RELEASE_IN_PROGRESS:
+      return 11;
+    case FaultStatus::INTERNAL_FAULT:
+      return 12;
+    case FaultStatus::ACTIVATION_FAULT:
+      return 13;
+    case FaultStatus::OVERCURRENT:
+      return 14;
+    case FaultStatus::AUTOMATIC_RELEASE_COMPLETED:
+      return 15;
+    default:
+      return 1;  // Reserved code, decoded as UNKNOWN
+  }
+}
+
+uint8_t ratio_to_word(double ratio) {
+  return static_cast<uint8_t>(std::round(std::min(std::max(ratio, 0.0), 1.0) * 255.0));
+}
+
 std::string crc16_modbus(const std::string& input) {
   // Pad the input with zeros every other character to be able to use stringstream
   std::string msg = "";
@@ -14,19 +14,25 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
-#include <boost/asio/serial_port.hpp>
+#include "robotiq/transport.h"
+#include "robotiq/types.h"
 
 namespace robotiq {
 
-/** Writes a message to the serial port and returns the received message */
-std::string write_read(boost::asio::serial_port& serial, const std::string& message,
-                          std::size_t timeout_ms);
+/**
+ * Reads up to expected_bytes from the transport, or until the inactivity timeout.  A
+ * modbus exception response ends the read early.  Sets first_byte, if given, to the time
+ * the first byte was read.
+ */
+std::string read(Transport& transport, std::size_t timeout_ms, std::size_t expected_bytes,
+                 std::chrono::steady_clock::time_point* first_byte = nullptr);
 
-/** Writes a message to the serial port and does not wait for a response*/
-void write(boost::asio::serial_port& serial, const std::string& message);
+/** Writes a message to the transport and does not wait for a response*/
+bool write(Transport& transport, const std::string& message);
 
 /** Converts a binary string to a hexidecimal string */
 std::string bin_to_hex(const std::string& input);
@@ -37,6 +43,24 @@ std::string hex_to_bin(const std::string& input);
 /** Converts an integer value to a fixed width hex string*/
 std::string uint8_to_hex(uint8_t value);
 
+/** Converts an integer value to a fixed width hex string*/
+std::string uint16_to_hex(uint16_t value);
+
+/** Converts a fixed width hex string to an integer value*/
+uint16_t hex_to_uint16(const std::string& input);
+
+/** Returns true if the hexidecimal message ends with its valid modbus CRC*/
+bool has_valid_crc(const std::string& input);
+
+/** Converts a gFLT fault code to a fault status*/
+FaultStatus code_to_fault(uint8_t code);
+
+/** Converts a fault status to its gFLT fault code*/
+uint8_t fault_to_code(FaultStatus fault);
+
+/** Converts a ratio between 0 and 1 to a register word, clamping out of range values*/
+uint8_t ratio_to_word(double ratio);
+
 /** Computes the modbus CRC (cyclic redundancy check) for a hexidecimal string*/
 std::string crc16_modbus(const std::string& input);
 
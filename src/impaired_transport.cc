@@ -0,0 +1,161 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/simulation.h"
+#include "src/helpers.h"
+
+#include <thread>
+
+namespace robotiq {
+
+// Function codes, which determine the size of a response
+static const uint8_t FC_READ_HOLDING_REGISTERS = 0x03;
+static const uint8_t FC_READ_INPUT_REGISTERS = 0x04;
+static const uint8_t FC_PRESET_SINGLE_REGISTER = 0x06;
+static const uint8_t FC_PRESET_MULTIPLE_REGISTERS = 0x10;
+
+// Status register reads after the slave id, their responses carry gFLT
+static const std::string READ_STATUS_REQUEST = "0307D0";
+static const std::string READ_INPUT_STATUS_REQUEST = "0407D0";
+
+// Offset of the fault register byte in a status response
+static const std::size_t FAULT_OFFSET = 5;
+
+ImpairedTransport::ImpairedTransport(std::unique_ptr<Transport> transport,
+                                     const ImpairmentProfile& profile)
+    : m_transport(std::move(transport)), m_profile(profile), m_random(profile.seed) {}
+
+bool ImpairedTransport::write(const std::string& bytes) {
+  auto now = Clock::now();
+  if (now < m_port_back) {
+    return false;
+  }
+  if (chance(m_profile.port_loss_probability)) {
+    ++m_counters.port_losses;
+    m_port_back = now + std::chrono::milliseconds(m_profile.port_loss_ms);
+    return false;
+  }
+
+  m_frame.clear();
+  m_next = 0;
+  m_awaiting_response = true;
+  std::string request = bin_to_hex(bytes).substr(2, READ_STATUS_REQUEST.size());
+  m_status_request =
+      request == READ_STATUS_REQUEST || request == READ_INPUT_STATUS_REQUEST;
+  return m_transport->write(bytes);
+}
+
+bool ImpairedTransport::read_byte(char& c, std::size_t timeout_ms) {
+  // A port that disappeared fails immediately, like a serial device that was unplugged
+  if (Clock::now() < m_port_back) {
+    return false;
+  }
+
+  if (m_awaiting_response) {
+    m_awaiting_response = false;
+    receive_frame(timeout_ms);
+  }
+  if (m_next >= m_frame.size()) {
+    return m_transport->read_byte(c, timeout_ms);
+  }
+
+  auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+  if (m_ready > deadline) {
+    std::this_thread::sleep_until(deadline);
+    return false;
+  }
+  std::this_thread::sleep_until(m_ready);
+  c = m_frame[m_next++];
+  return true;
+}
+
+void ImpairedTransport::flush_input() {
+  m_frame.clear();
+  m_next = 0;
+  m_awaiting_response = false;
+  m_transport->flush_input();
+}
+
+bool ImpairedTransport::chance(double probability) {
+  return std::uniform_real_distribution<double>(0, 1)(m_random) < probability;
+}
+
+void ImpairedTransport::receive_frame(std::size_t timeout_ms) {
+  // The size follows from the function code, and the byte count of read responses
+  char c;
+  std::size_t size = 2;
+  while (m_frame.size() < size && m_transport->read_byte(c, timeout_ms)) {
+    m_frame += c;
+    if (m_frame.size() == 2) {
+      uint8_t function = static_cast<uint8_t>(m_frame[1]);
+      if (function & 0x80) {
+        size = 5;
+      } else if (function == FC_READ_HOLDING_REGISTERS ||
+                 function == FC_READ_INPUT_REGISTERS) {
+        size = 3;
+      } else if (function == FC_PRESET_SINGLE_REGISTER ||
+                 function == FC_PRESET_MULTIPLE_REGISTERS) {
+        size = 8;
+      }
+    } else if (m_frame.size() == 3 && size == 3) {
+      size = 5 + static_cast<uint8_t>(m_frame[2]);
+    }
+  }
+
+  m_ready = Clock::now();
+  impair(m_frame);
+}
+
+void ImpairedTransport::impair(std::string& frame) {
+  if (frame.empty()) {
+    return;
+  }
+  ++m_counters.frames;
+
+  // Draw every impairment for every frame so the sequence only depends on the seed
+  bool fault = chance(m_profile.fault_probability);
+  bool flip = chance(m_profile.flip_bit_probability);
+  bool drop = chance(m_profile.drop_byte_probability);
+  bool truncate = chance(m_profile.truncate_probability);
+  bool delay = chance(m_profile.delay_probability);
+  std::size_t position = m_random();
+
+  // Faults are reported by the gripper, so the response keeps a valid CRC
+  if (fault && m_status_request && frame.size() > FAULT_OFFSET + 2) {
+    ++m_counters.faults;
+    frame[FAULT_OFFSET] = static_cast<char>((frame[FAULT_OFFSET] & 0xF0) |
+                                            fault_to_code(m_profile.fault));
+    std::string body = bin_to_hex(frame.substr(0, frame.size() - 2));
+    frame = hex_to_bin(body + crc16_modbus(body));
+  }
+  if (flip) {
+    ++m_counters.flipped_bits;
+    std::size_t bit = position % (8 * frame.size());
+    frame[bit / 8] = static_cast<char>(frame[bit / 8] ^ (1 << (bit % 8)));
+  }
+  if (drop) {
+    ++m_counters.dropped_bytes;
+    frame.erase(position % frame.size(), 1);
+  }
+  if (truncate && not frame.empty()) {
+    ++m_counters.truncated;
+    frame.resize(position % frame.size());
+  }
+  if (delay) {
+    ++m_counters.delayed;
+    m_ready += std::chrono::microseconds(m_profile.delay_us);
+  }
+}
+
+}  // namespace robotiq
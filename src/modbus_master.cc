@@ -0,0 +1,206 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/modbus_master.h"
+#include "src/helpers.h"
+
+#include <algorithm>
+
+namespace robotiq {
+
+// Function code of register writes
+static std::string FC_PRESET_MULTIPLE_REGISTERS = "10";
+
+// Size of the response to a register write in bytes
+static const std::size_t WRITE_RESPONSE_BYTES = 8;
+
+// Classifies a response to a request expecting expected_bytes that starts with header
+static ErrorCode check_response(const std::string& r, const std::string& header,
+                                std::size_t expected_bytes) {
+  if (r.empty()) {
+    return ErrorCode::TIMEOUT;
+  }
+  // Exception response: slave id, function code with bit 7 set, exception code, crc
+  if (r.size() == 10 && (hex_to_bin(r.substr(2, 2))[0] & 0x80)) {
+    return has_valid_crc(r) ? ErrorCode::MODBUS_EXCEPTION : ErrorCode::BAD_CRC;
+  }
+  if (r.size() != 2 * expected_bytes) {
+    return ErrorCode::TIMEOUT;
+  }
+  if (not has_valid_crc(r)) {
+    return ErrorCode::BAD_CRC;
+  }
+  if (r.compare(0, header.size(), header) != 0) {
+    return ErrorCode::UNEXPECTED_RESPONSE;
+  }
+  return ErrorCode::NONE;
+}
+
+ModbusMaster::ModbusMaster() : m_timeout_ms{DEFAULT_RECEIVE_TIMEOUT_MS} {
+  set_slave_id(DEFAULT_SLAVE_ID);
+}
+
+void ModbusMaster::set_slave_id(uint8_t slave_id) { m_slave = uint8_to_hex(slave_id); }
+
+ErrorCode ModbusMaster::send(const std::string& message) {
+  if (not m_transport) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+  // Discard responses left over from non-blocking commands so they are not mistaken
+  // for the response to this message
+  m_transport->flush_input();
+  ++m_transactions;
+  if (not robotiq::write(*m_transport, message)) {
+    m_response.clear();
+    return ErrorCode::PORT_ERROR;
+  }
+  return ErrorCode::NONE;
+}
+
+ErrorCode ModbusMaster::receive(const std::string& header, std::size_t expected_bytes) {
+  if (not m_transport) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+  m_response = robotiq::read(*m_transport, m_timeout_ms, expected_bytes, &m_first_byte);
+  return check_response(m_response, header, expected_bytes);
+}
+
+ErrorCode ModbusMaster::transact(const std::string& message, const std::string& header,
+                                 std::size_t expected_bytes) {
+  ErrorCode error = send(message);
+  if (error != ErrorCode::NONE) {
+    return error;
+  }
+  return receive(header, expected_bytes);
+}
+
+ErrorCode ModbusMaster::read(RegisterTable table, uint16_t address, uint16_t count,
+                             std::vector<uint16_t>& values) {
+  if (count == 0 || count > MAX_REGISTER_COUNT) {
+    return ErrorCode::INVALID_ARGUMENT;
+  }
+  std::string function = uint8_to_hex(static_cast<uint8_t>(table));
+  std::string message =
+      m_slave + function + uint16_to_hex(address) + uint16_to_hex(count);
+  message += crc16_modbus(message);
+
+  // Response: slave id, function code, byte count, data, crc
+  std::string header = m_slave + function + uint8_to_hex(static_cast<uint8_t>(2 * count));
+  std::size_t expected_bytes = 5 + 2 * static_cast<std::size_t>(count);
+  ErrorCode error = transact(message, header, expected_bytes);
+  if (error != ErrorCode::NONE) {
+    return error;
+  }
+  values.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    values[i] = hex_to_uint16(m_response.substr(6 + 4 * i, 4));
+  }
+  return ErrorCode::NONE;
+}
+
+ErrorCode ModbusMaster::write(uint16_t address, const std::vector<uint16_t>& values) {
+  if (values.empty() || values.size() > MAX_REGISTER_COUNT) {
+    return ErrorCode::INVALID_ARGUMENT;
+  }
+  uint16_t count = static_cast<uint16_t>(values.size());
+  std::string header = m_slave + FC_PRESET_MULTIPLE_REGISTERS + uint16_to_hex(address) +
+                       uint16_to_hex(count);
+  std::string message = header + uint8_to_hex(static_cast<uint8_t>(2 * count));
+  for (uint16_t value : values) {
+    message += uint16_to_hex(value);
+  }
+  message += crc16_modbus(message);
+
+  // Response: echo of the slave id, function code, address and count, then crc
+  return transact(message, header, WRITE_RESPONSE_BYTES);
+}
+
+ErrorCode ModbusMaster::execute() {
+  ErrorCode first_error = ErrorCode::NONE;
+  std::size_t begin = 0;
+  while (begin < m_queue.size()) {
+    // A write is a barrier, reads are not moved across it
+    ErrorCode error;
+    if (m_queue[begin].write) {
+      RegisterWrite& write = *m_queue[begin].write;
+      error = write.error = this->write(write.address, write.values);
+      ++begin;
+    } else {
+      std::size_t end = begin;
+      while (end < m_queue.size() && not m_queue[end].write) {
+        ++end;
+      }
+      error = execute_reads(begin, end);
+      begin = end;
+    }
+    if (first_error == ErrorCode::NONE) {
+      first_error = error;
+    }
+  }
+  m_queue.clear();
+  return first_error;
+}
+
+ErrorCode ModbusMaster::execute_reads(std::size_t begin, std::size_t end) {
+  ErrorCode first_error = ErrorCode::NONE;
+  m_batch.clear();
+  for (std::size_t i = begin; i < end; ++i) {
+    RegisterRead* read = m_queue[i].read;
+    if (read->count == 0 || read->count > MAX_REGISTER_COUNT) {
+      read->error = ErrorCode::INVALID_ARGUMENT;
+      first_error = ErrorCode::INVALID_ARGUMENT;
+    } else {
+      m_batch.push_back(read);
+    }
+  }
+  std::sort(m_batch.begin(), m_batch.end(), [](RegisterRead* a, RegisterRead* b) {
+    return a->table != b->table ? a->table < b->table : a->address < b->address;
+  });
+
+  std::size_t first = 0;
+  while (first < m_batch.size()) {
+    // Extend the span over the next reads while they touch it and it fits a message
+    RegisterTable table = m_batch[first]->table;
+    uint32_t start = m_batch[first]->address;
+    uint32_t stop = start + m_batch[first]->count;
+    std::size_t last = first + 1;
+    while (last < m_batch.size() && m_batch[last]->table == table &&
+           m_batch[last]->address <= stop &&
+           std::max<uint32_t>(stop, m_batch[last]->address + m_batch[last]->count) -
+                   start <=
+               MAX_REGISTER_COUNT) {
+      stop = std::max<uint32_t>(stop, m_batch[last]->address + m_batch[last]->count);
+      ++last;
+    }
+
+    ErrorCode error = read(table, static_cast<uint16_t>(start),
+                           static_cast<uint16_t>(stop - start), m_values);
+    for (std::size_t i = first; i < last; ++i) {
+      RegisterRead& read = *m_batch[i];
+      read.error = error;
+      if (error == ErrorCode::NONE) {
+        auto values = m_values.begin() + (read.address - start);
+        read.values.assign(values, values + read.count);
+      }
+    }
+    if (first_error == ErrorCode::NONE) {
+      first_error = error;
+    }
+    m_merged_reads += last - first - 1;
+    first = last;
+  }
+  return first_error;
+}
+
+}  // namespace robotiq
@@ -0,0 +1,118 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "robotiq/registers.h"
+#include "robotiq/result.h"
+#include "robotiq/transport.h"
+
+namespace robotiq {
+
+/**
+ * Modbus RTU master addressing one slave over a transport.  It builds and checks the
+ * frames of the transactions, and executes queued register requests with as few
+ * transactions as possible: the reads of a table queued between two writes that are
+ * adjacent or overlap are merged into one read, whose values are split back to each
+ * request.  Messages are hexadecimal strings as in src/helpers.h.
+ */
+class ModbusMaster {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  ModbusMaster();
+
+  /** Sets the transport, owned by the caller, or null */
+  void set_transport(Transport* transport) { m_transport = transport; }
+
+  /** Addresses the messages to a slave id */
+  void set_slave_id(uint8_t slave_id);
+
+  /** Returns the slave id as the two hexadecimal characters that start the messages */
+  const std::string& slave() const { return m_slave; }
+
+  void set_timeout(std::size_t timeout_ms) { m_timeout_ms = timeout_ms; }
+  std::size_t timeout() const { return m_timeout_ms; }
+
+  /** Discards leftover input and writes a message whose response is read by receive() */
+  ErrorCode send(const std::string& message);
+
+  /**
+   * Reads the response to the last message into response(), returns NONE if it is
+   * complete, valid and starts with the header
+   */
+  ErrorCode receive(const std::string& header, std::size_t expected_bytes);
+
+  /** Sends a message and receives its response */
+  ErrorCode transact(const std::string& message, const std::string& header,
+                     std::size_t expected_bytes);
+
+  /** Reads consecutive registers of a table */
+  ErrorCode read(RegisterTable table, uint16_t address, uint16_t count,
+                 std::vector<uint16_t>& values);
+
+  /** Writes consecutive registers (FC16) */
+  ErrorCode write(uint16_t address, const std::vector<uint16_t>& values);
+
+  /** Queues a request for execute(), it must stay alive until then */
+  void queue(RegisterRead& read) { m_queue.push_back({&read, nullptr}); }
+  void queue(RegisterWrite& write) { m_queue.push_back({nullptr, &write}); }
+
+  /** Empties the queue without executing it */
+  void clear() { m_queue.clear(); }
+
+  /**
+   * Executes the queued requests in order, merging reads between writes, and empties
+   * the queue.  Each request holds its own outcome, the first error is returned.
+   */
+  ErrorCode execute();
+
+  /** Last response as hexadecimal characters, and the time its first byte was read */
+  const std::string& response() const { return m_response; }
+  Clock::time_point first_byte() const { return m_first_byte; }
+
+  /** Messages sent, and reads that were merged into the transaction of another read */
+  uint64_t transactions() const { return m_transactions; }
+  uint64_t merged_reads() const { return m_merged_reads; }
+
+ private:
+  struct Request {
+    RegisterRead* read;
+    RegisterWrite* write;
+  };
+
+  /** Executes the reads of the queue in [begin, end), which holds no write */
+  ErrorCode execute_reads(std::size_t begin, std::size_t end);
+
+  Transport* m_transport{nullptr};
+  std::string m_slave;
+  std::size_t m_timeout_ms;
+  std::string m_response;
+  Clock::time_point m_first_byte;
+  uint64_t m_transactions{0};
+  uint64_t m_merged_reads{0};
+
+  // Reused so that executing a queue does not allocate once warmed up
+  std::vector<Request> m_queue;
+  std::vector<RegisterRead*> m_batch;
+  std::vector<uint16_t> m_values;
+};
+
+}  // namespace robotiq
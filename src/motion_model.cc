@@ -0,0 +1,99 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/motion_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robotiq {
+
+// Prior rate before any motion has been observed.  The 2F-85 covers its full stroke in
+// roughly 0.6 s at maximum speed, i.e. about 400 counts per second.
+static const double PRIOR_RATE = 400.0;
+
+// Ratio of the minimum to the maximum finger speed (20 mm/s and 150 mm/s on the 2F-85)
+static const double DEFAULT_MIN_SPEED_RATIO = 20.0 / 150.0;
+
+// Bounds on a single rate observation, used to reject samples taken around stalls and
+// direction changes.
+static const double MIN_RATE = 20.0;
+static const double MAX_RATE = 2000.0;
+
+// Gain of the exponential filter applied to rate observations
+static const double RATE_GAIN = 0.3;
+
+// Fraction of the predicted remaining time to wait before the next poll.  Waiting only
+// part of the prediction keeps the completion latency bounded when the fingers stop
+// early on an object.
+static const double POLL_FRACTION = 0.5;
+
+// Below this delay the gripper is polled back to back
+static const std::chrono::microseconds MIN_POLL_DELAY(5000);
+
+// Upper bound on the delay between polls
+static const std::chrono::microseconds MAX_POLL_DELAY(250000);
+
+MotionModel::MotionModel()
+    : m_rate{PRIOR_RATE}, m_min_speed_ratio{DEFAULT_MIN_SPEED_RATIO} {}
+
+void MotionModel::update(uint8_t raw_position, bool in_motion, Clock::time_point stamp) {
+  if (not in_motion) {
+    reset_segment();
+    return;
+  }
+
+  if (m_has_sample) {
+    double dt = std::chrono::duration<double>(stamp - m_last_stamp).count();
+    double distance = std::abs(static_cast<double>(raw_position) - m_last_position);
+    if (dt > 0 && distance > 0) {
+      double observed = distance / dt / m_speed_factor;
+      if (observed >= MIN_RATE && observed <= MAX_RATE) {
+        m_rate += RATE_GAIN * (observed - m_rate);
+      }
+    }
+  }
+
+  m_has_sample = true;
+  m_last_position = raw_position;
+  m_last_stamp = stamp;
+}
+
+void MotionModel::reset_segment() { m_has_sample = false; }
+
+void MotionModel::configure(double full_stroke_time_s, double min_speed_ratio) {
+  m_rate = 255.0 / full_stroke_time_s;
+  m_min_speed_ratio = min_speed_ratio;
+}
+
+void MotionModel::set_speed(uint8_t speed) {
+  m_speed_factor = m_min_speed_ratio + (1.0 - m_min_speed_ratio) * speed / 255.0;
+}
+
+double MotionModel::time_to_target(uint8_t raw_position, uint8_t raw_target) const {
+  double distance = std::abs(static_cast<double>(raw_target) - raw_position);
+  return distance / rate();
+}
+
+std::chrono::microseconds MotionModel::poll_delay(uint8_t raw_position,
+                                                  uint8_t raw_target) const {
+  std::chrono::microseconds delay(static_cast<int64_t>(
+      POLL_FRACTION * time_to_target(raw_position, raw_target) * 1e6));
+  if (delay < MIN_POLL_DELAY) {
+    return std::chrono::microseconds(0);
+  }
+  return std::min(delay, MAX_POLL_DELAY);
+}
+
+}  // namespace robotiq
@@ -0,0 +1,66 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace robotiq {
+
+/**
+ * Kinematic model of the finger travel, learned online from feedback samples.  The
+ * model tracks the finger rate in raw position counts per second and uses it to predict
+ * when a move will reach its commanded position.
+ */
+class MotionModel {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  MotionModel();
+
+  /** Adds a feedback sample, learning the finger rate while the gripper is in motion */
+  void update(uint8_t raw_position, bool in_motion, Clock::time_point stamp);
+
+  /** Forgets the previous sample, e.g. when a new motion is commanded */
+  void reset_segment();
+
+  /**
+   * Sets the prior rate from the time to cover the full stroke at maximum speed, and the
+   * ratio of the minimum to the maximum finger speed of the gripper model
+   */
+  void configure(double full_stroke_time_s, double min_speed_ratio);
+
+  /** Sets the commanded speed word, which scales the predicted finger rate */
+  void set_speed(uint8_t speed);
+
+  /** Returns the predicted time in seconds to travel between two raw positions */
+  double time_to_target(uint8_t raw_position, uint8_t raw_target) const;
+
+  /** Returns how long to wait before the next poll; sparse early, dense near arrival */
+  std::chrono::microseconds poll_delay(uint8_t raw_position, uint8_t raw_target) const;
+
+  /** Returns the learned finger rate at the commanded speed in raw counts per second */
+  double rate() const { return m_rate * m_speed_factor; }
+
+ private:
+  double m_rate;  // At maximum speed
+  double m_speed_factor{1};
+  double m_min_speed_ratio;
+  bool m_has_sample{false};
+  uint8_t m_last_position{0};
+  Clock::time_point m_last_stamp;
+};
+
+}  // namespace robotiq
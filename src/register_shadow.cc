@@ -0,0 +1,124 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/register_shadow.h"
+
+namespace robotiq {
+
+// Bits of every known output register
+static const uint8_t ALL_OUTPUTS = 0x07;
+
+// rACT and rGTO in the first output byte, echoed by gACT and gGTO in the first input byte
+static const uint16_t ACTION_BITS = 0x0900;
+
+// Position request in the second output register, echoed by gPR in the second input one
+static const uint16_t POSITION_BITS = 0x00FF;
+
+// gFLT in the second input register
+static const uint16_t FAULT_BITS = 0x0F00;
+
+void RegisterShadow::sent(uint16_t address, const uint16_t* values, std::size_t count) {
+  std::size_t covered = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::size_t index = address + i - OUTPUT_REGISTERS_ADDRESS;
+    if (address + i >= OUTPUT_REGISTERS_ADDRESS && index < m_outputs.size()) {
+      // Changing rACT or rGTO changes the status, so the inputs read before are stale
+      if (index == 0 && ((m_known_outputs & 0x01) == 0 ||
+                         (m_outputs[0] & ACTION_BITS) != (values[i] & ACTION_BITS))) {
+        m_known_inputs = false;
+      }
+      m_outputs[index] = values[i];
+      m_known_outputs |= static_cast<uint8_t>(1 << index);
+      ++covered;
+    }
+  }
+  // Only a write of every output register tells them all once acknowledged
+  m_full_write = covered == m_outputs.size();
+  if (covered > 0) {
+    m_confirmed = false;
+  }
+}
+
+void RegisterShadow::acknowledged() {
+  m_confirmed = m_full_write && m_known_outputs == ALL_OUTPUTS;
+}
+
+void RegisterShadow::received(uint16_t address, const uint16_t* values, std::size_t count,
+                              Clock::time_point time) {
+  std::size_t outputs = 0;
+  std::size_t inputs = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::size_t output = address + i - OUTPUT_REGISTERS_ADDRESS;
+    std::size_t input = address + i - INPUT_REGISTERS_ADDRESS;
+    if (address + i >= OUTPUT_REGISTERS_ADDRESS && output < m_outputs.size()) {
+      m_outputs[output] = values[i];
+      m_known_outputs |= static_cast<uint8_t>(1 << output);
+      ++outputs;
+    } else if (address + i >= INPUT_REGISTERS_ADDRESS && input < m_inputs.size()) {
+      m_inputs[input] = values[i];
+      ++inputs;
+    }
+  }
+
+  // Outputs read back are the state of the gripper
+  if (outputs > 0) {
+    m_confirmed = m_known_outputs == ALL_OUTPUTS;
+  }
+
+  // The freshness covers every input register, so partial reads make the inputs unknown
+  if (inputs > 0) {
+    m_known_inputs = inputs == m_inputs.size();
+    m_inputs_time = time;
+    if (m_known_inputs && not m_confirmed && m_known_outputs == ALL_OUTPUTS &&
+        inputs_echo_outputs()) {
+      m_confirmed = true;
+    }
+  }
+}
+
+void RegisterShadow::invalidate_outputs() {
+  m_known_outputs = 0;
+  m_confirmed = false;
+  m_full_write = false;
+}
+
+void RegisterShadow::invalidate() {
+  invalidate_outputs();
+  m_known_inputs = false;
+}
+
+bool RegisterShadow::is_redundant(const Registers& outputs, Clock::time_point now,
+                                  Clock::duration freshness) const {
+  Registers inputs;
+  return m_confirmed && m_known_outputs == ALL_OUTPUTS && m_outputs == outputs &&
+         fresh_inputs(now, freshness, inputs) && (inputs[1] & FAULT_BITS) == 0 &&
+         inputs_echo_outputs();
+}
+
+bool RegisterShadow::fresh_inputs(Clock::time_point now, Clock::duration freshness,
+                                  Registers& inputs) const {
+  if (not m_known_inputs || freshness <= Clock::duration::zero() ||
+      now - m_inputs_time > freshness) {
+    return false;
+  }
+  inputs = m_inputs;
+  return true;
+}
+
+bool RegisterShadow::inputs_echo_outputs() const {
+  return (m_inputs[0] & ACTION_BITS) == (m_outputs[0] & ACTION_BITS) &&
+         (m_inputs[1] & POSITION_BITS) == (m_outputs[1] & POSITION_BITS);
+}
+
+}  // namespace robotiq
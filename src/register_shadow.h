@@ -0,0 +1,85 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace robotiq {
+
+/** First output (command) register of the gripper */
+const uint16_t OUTPUT_REGISTERS_ADDRESS = 0x03E8;
+
+/** First input (status) register of the gripper */
+const uint16_t INPUT_REGISTERS_ADDRESS = 0x07D0;
+
+/**
+ * Shadow copy of the three output registers and the three input registers of the
+ * gripper, maintained from every transaction.  A write is confirmed once the gripper
+ * acknowledged it, or once the feedback echoes its action bits and position, so that a
+ * command equal to the confirmed state can be skipped, and status queries can be
+ * answered from inputs read within a freshness window.
+ */
+class RegisterShadow {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Registers = std::array<uint16_t, 3>;
+
+  /**
+   * Records a write sent to the gripper, unconfirmed until acknowledged or echoed.  A
+   * write that may change rACT or rGTO forgets the inputs, whose status it changes.
+   */
+  void sent(uint16_t address, const uint16_t* values, std::size_t count);
+
+  /** Confirms the writes sent, on their acknowledgement */
+  void acknowledged();
+
+  /** Records registers read from the gripper at a time */
+  void received(uint16_t address, const uint16_t* values, std::size_t count,
+                Clock::time_point time);
+
+  /** Forgets the output registers, e.g. after a write of unknown outcome */
+  void invalidate_outputs();
+
+  /** Forgets every register, e.g. when the gripper may have changed */
+  void invalidate();
+
+  /**
+   * Returns true if the outputs are confirmed equal to the given ones and inputs read
+   * within the freshness show the gripper executing them without a fault
+   */
+  bool is_redundant(const Registers& outputs, Clock::time_point now,
+                    Clock::duration freshness) const;
+
+  /** Returns true and the inputs if they were read within the freshness */
+  bool fresh_inputs(Clock::time_point now, Clock::duration freshness,
+                    Registers& inputs) const;
+
+ private:
+  /** Returns true if the inputs echo the action bits and position of the outputs */
+  bool inputs_echo_outputs() const;
+
+  Registers m_outputs{};
+  uint8_t m_known_outputs{0};  // Bit i set if output register i is known
+  bool m_confirmed{false};
+  bool m_full_write{false};  // Last write sent covered every output register
+  Registers m_inputs{};
+  bool m_known_inputs{false};
+  Clock::time_point m_inputs_time;
+};
+
+}  // namespace robotiq
@@ -0,0 +1,64 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/result.h"
+
+#include <string>
+
+namespace robotiq {
+
+const char* to_string(ErrorCode code) {
+  switch (code) {
+    case ErrorCode::NONE:
+      return "success";
+    case ErrorCode::NOT_CONNECTED:
+      return "gripper not connected";
+    case ErrorCode::PORT_ERROR:
+      return "port error";
+    case ErrorCode::TIMEOUT:
+      return "response timeout";
+    case ErrorCode::BAD_CRC:
+      return "bad response crc";
+    case ErrorCode::UNEXPECTED_RESPONSE:
+      return "unexpected response";
+    case ErrorCode::MODBUS_EXCEPTION:
+      return "modbus exception";
+    case ErrorCode::MOTION_TIMEOUT:
+      return "motion timeout";
+    case ErrorCode::INVALID_ARGUMENT:
+      return "invalid argument";
+    case ErrorCode::FILE_ERROR:
+      return "file error";
+  }
+  return "unknown error";
+}
+
+namespace {
+
+class RobotiqErrorCategory : public std::error_category {
+ public:
+  const char* name() const noexcept override { return "robotiq"; }
+  std::string message(int code) const override {
+    return to_string(static_cast<ErrorCode>(code));
+  }
+};
+
+}  // namespace
+
+const std::error_category& error_category() {
+  static RobotiqErrorCategory category;
+  return category;
+}
+
+}  // namespace robotiq
@@ -14,175 +14,483 @@
 
 #include "robotiq/robotiq_gripper_interface.h"
 #include "src/helpers.h"
+#include "src/modbus_master.h"
+#include "src/motion_model.h"
+#include "src/register_shadow.h"
+#include "src/shared_feedback_publisher.h"
+#include "src/telemetry_recorder.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
-#include <iostream>
 #include <thread>
 
-#include <boost/asio.hpp>
-#include <boost/bind.hpp>
-
-using namespace boost;
-
 namespace robotiq {
 
-// Messages for reading holding registers (FC03 from the manual)
-static std::string READ_FEEDBACK = "090307D00003040E";
+// The messages below follow the slave id and are ended with a CRC check once addressed
+
+// Message for reading holding registers (FC03 from the manual)
+static std::string READ_FEEDBACK = "0307D00003";
 
 // Messages for preseting multiple registers (FC16 from the manual)
-static std::string PRESET_RESET = "091003E80003060000000000007330";
-static std::string PRESET_ACTIVATE = "091003E800030601000000000072E1";
+static std::string PRESET_RESET = "1003E8000306000000000000";
+static std::string PRESET_ACTIVATE = "1003E8000306010000000000";
 
 // Position commands are prefixed by preset for multiple registers (FC16 from the manual)
-// and a postfix to set max current and velocity.  The word is ended with a CRC check on
-// the unique message.
-static std::string PRESET_POSITION_PREFIX = "091003E8000306090000";
-static std::string PRESET_POSITION_POSTFIX = "FFFF";
+// and followed by the position, speed and force words.
+static std::string PRESET_POSITION_PREFIX = "1003E8000306090000";
+
+// Echo of the preset requests in their response
+static std::string PRESET_HEADER = "1003E80003";
+
+// Function code and byte count of the response to READ_FEEDBACK
+static std::string FEEDBACK_HEADER = "0306";
+
+// gACT in the first input register
+static const uint16_t GACT_BIT = 0x0100;
 
-// Expected response for preset messages
-static std::string PRESET_RESPONSE = "091003E800030130";
+// Maximum speed and force words
+static const uint8_t MAX_SPEED = 255;
+static const uint8_t MAX_FORCE = 255;
+
+// Distance in raw counts from the end of a grasp approach at which to slow down
+static const uint8_t APPROACH_TOLERANCE = 4;
+
+// Bits of a byte on the wire: start, 8 data and stop bits
+static const double BITS_PER_BYTE = 10;
+
+// Size of the responses to preset messages and to READ_FEEDBACK in bytes
+static const std::size_t PRESET_RESPONSE_BYTES = 8;
+static const std::size_t FEEDBACK_RESPONSE_BYTES = 11;
 
 struct RobotiqGripperInterface::Implementation {
   Implementation();
   bool is_connected{false};
-  asio::io_service m_io_service;
-  asio::serial_port m_serial;
-  std::size_t m_timeout_ms;
-  double m_scale_alpha;
-  double m_scale_beta;
+  std::unique_ptr<Transport> m_transport;
+
+  // Messages addressed to the slave id, with their CRC
+  uint8_t m_slave_id{DEFAULT_SLAVE_ID};
+  std::string m_slave;
+  std::string m_read_feedback;
+  std::string m_preset_reset;
+  std::string m_preset_activate;
+  std::string m_preset_header;
+  std::string m_feedback_header;
+
+  SerialOptions m_serial_options;
+  SerialLatencyReport m_serial_report;
+  std::size_t m_motion_timeout_ms{DEFAULT_MOTION_TIMEOUT_MS};
+  double m_scale_beta{DEFAULT_SCALE_BETA};
+
+  // Slopes of the position scaling, precomputed so that conversions do not divide
+  double m_position_per_word{DEFAULT_SCALE_ALPHA / 255.0};
+  double m_word_per_position{255.0 / DEFAULT_SCALE_ALPHA};
+
+  ModelParameters m_model;
+
+  // Nonlinear calibration, used instead of the scale factors when valid
+  Calibration m_calibration;
+  std::string m_calibration_path;
+
+  MotionModel m_motion_model;
+  GripperFeedback m_last_feedback{};
+  bool m_predictive_polling{true};
+  SharedFeedbackPublisher m_publisher;
+  TelemetryRecorder m_recorder;
+  std::function<void(const GripperFeedback&)> m_feedback_callback;
+
+  // Position command sent without waiting for its response yet
+  bool m_has_pending_command{false};
+  TelemetrySample m_pending_command;
+
+  // Frames and transactions, and the register requests queued for execute_requests()
+  ModbusMaster m_master;
+  std::vector<std::pair<RegisterRead*, RegisterWrite*>> m_queued;
+
+  // Time to transmit a byte at the baud rate, and the recent feedback for interpolation
+  std::chrono::nanoseconds m_byte_time{byte_time(DEFAULT_BAUD)};
+  FeedbackRing m_ring;
+
+  // Shadow registers, and whether the last position command was skipped as redundant
+  RegisterShadow m_shadow;
+  std::chrono::milliseconds m_cache_freshness{0};
+  RegisterCacheStats m_cache_stats;
+  bool m_command_skipped{false};
+
+  /** Confirms the outputs sent on success, or forgets them as their state is unknown */
+  void update_outputs(ErrorCode error) {
+    error == ErrorCode::NONE ? m_shadow.acknowledged() : m_shadow.invalidate_outputs();
+  }
+
+  /** Returns the time to transmit a byte at a baud rate */
+  static std::chrono::nanoseconds byte_time(std::size_t baud) {
+    return std::chrono::nanoseconds(static_cast<int64_t>(BITS_PER_BYTE * 1e9 / baud));
+  }
+
+  /** Addresses the messages to a slave id */
+  void set_slave_id(uint8_t slave_id);
+
+  /** Creates a position command with its modbus CRC check */
+  std::string position_message(uint8_t position, uint8_t speed, uint8_t force) const;
+
+  /** Returns the time after which a blocking motion fails */
+  MotionModel::Clock::time_point motion_deadline() const {
+    return MotionModel::Clock::now() + std::chrono::milliseconds(m_motion_timeout_ms);
+  }
+
+  /** Records a transaction, registers are the 12 hex characters of three registers */
+  void record(TelemetryRecordType type, const std::string& registers,
+              MotionModel::Clock::time_point sent,
+              MotionModel::Clock::time_point completed, bool valid);
+
+  /** Records the pending position command with its response */
+  void record_command_response(bool valid);
+
+  /** Records the pending position command as sent without a response */
+  void record_pending_command();
 };
 
-RobotiqGripperInterface::Implementation::Implementation()
-    : m_serial(m_io_service), m_timeout_ms{DEFAULT_RECEIVE_TIMEOUT_MS} {}
+// Creates a telemetry sample, registers are the 12 hex characters of three registers
+static TelemetrySample make_sample(TelemetryRecordType type, const std::string& registers,
+                                   MotionModel::Clock::time_point sent,
+                                   MotionModel::Clock::time_point completed, bool valid) {
+  TelemetrySample sample;
+  sample.stamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        completed.time_since_epoch())
+                        .count();
+  sample.latency_us = static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(completed - sent).count());
+  sample.type = type;
+  sample.flags = valid ? RECORD_RESPONSE_VALID : 0;
+  std::string bin = hex_to_bin(registers);
+  if (bin.size() == sizeof(sample.registers)) {
+    std::memcpy(sample.registers, bin.data(), sizeof(sample.registers));
+  }
+  return sample;
+}
+
+void RobotiqGripperInterface::Implementation::record(
+    TelemetryRecordType type, const std::string& registers,
+    MotionModel::Clock::time_point sent, MotionModel::Clock::time_point completed,
+    bool valid) {
+  if (m_recorder.is_open()) {
+    m_recorder.record(make_sample(type, registers, sent, completed, valid));
+  }
+}
+
+void RobotiqGripperInterface::Implementation::record_command_response(bool valid) {
+  if (not m_has_pending_command) {
+    return;
+  }
+  int64_t completed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             MotionModel::Clock::now().time_since_epoch())
+                             .count();
+  m_pending_command.latency_us =
+      static_cast<uint32_t>((completed_ns - m_pending_command.stamp_ns) / 1000);
+  m_pending_command.stamp_ns = completed_ns;
+  m_pending_command.flags = valid ? RECORD_RESPONSE_VALID : 0;
+  record_pending_command();
+}
+
+void RobotiqGripperInterface::Implementation::record_pending_command() {
+  if (m_has_pending_command) {
+    m_recorder.record(m_pending_command);
+    m_has_pending_command = false;
+  }
+}
+
+RobotiqGripperInterface::Implementation::Implementation() {
+  set_slave_id(DEFAULT_SLAVE_ID);
+}
+
+void RobotiqGripperInterface::Implementation::set_slave_id(uint8_t slave_id) {
+  auto with_crc = [](const std::string& message) {
+    return message + crc16_modbus(message);
+  };
+  m_slave_id = slave_id;
+  m_master.set_slave_id(slave_id);
+  m_slave = m_master.slave();
+  m_shadow.invalidate();
+  m_read_feedback = with_crc(m_slave + READ_FEEDBACK);
+  m_preset_reset = with_crc(m_slave + PRESET_RESET);
+  m_preset_activate = with_crc(m_slave + PRESET_ACTIVATE);
+  m_preset_header = m_slave + PRESET_HEADER;
+  m_feedback_header = m_slave + FEEDBACK_HEADER;
+}
+
+std::string RobotiqGripperInterface::Implementation::position_message(
+    uint8_t position, uint8_t speed, uint8_t force) const {
+  std::string message = m_slave + PRESET_POSITION_PREFIX + uint8_to_hex(position) +
+                        uint8_to_hex(speed) + uint8_to_hex(force);
+  return message + crc16_modbus(message);
+}
 
 RobotiqGripperInterface::RobotiqGripperInterface()
     : m_impl{std::make_unique<Implementation>()} {}
 
-RobotiqGripperInterface::~RobotiqGripperInterface() {
-  if (m_impl->is_connected) {
-    m_impl->m_serial.close();
+RobotiqGripperInterface::~RobotiqGripperInterface() { m_impl->record_pending_command(); }
+
+Result<void> RobotiqGripperInterface::connect(const std::string& port,
+                                              std::size_t baud,
+                                              double scale_alpha,
+                                              double scale_beta) {
+  auto transport = std::make_unique<SerialTransport>();
+  std::string error;
+  bool opened = transport->open(port, baud, error, m_impl->m_serial_options);
+  m_impl->m_serial_report = transport->latency_report();
+  if (not opened) {
+    m_impl->is_connected = false;
+    m_impl->m_transport.reset();
+    m_impl->m_master.set_transport(nullptr);
+    return ErrorCode::PORT_ERROR;
   }
+  m_impl->m_byte_time = Implementation::byte_time(baud);
+  return connect(std::move(transport), scale_alpha, scale_beta);
 }
 
-bool RobotiqGripperInterface::connect(const std::string& port,
-                                      std::size_t baud,
-                                      double scale_alpha,
-                                      double scale_beta) {
-  m_impl->m_scale_alpha = scale_alpha;
+Result<void> RobotiqGripperInterface::connect(std::unique_ptr<Transport> transport,
+                                              double scale_alpha, double scale_beta) {
   m_impl->m_scale_beta = scale_beta;
-
-  if (m_impl->is_connected) {
-    m_impl->m_serial.close();
+  m_impl->m_position_per_word = scale_alpha / 255.0;
+  m_impl->m_word_per_position = 255.0 / scale_alpha;
+  if (not m_impl->m_calibration_path.empty()) {
+    m_impl->m_calibration.load(m_impl->m_calibration_path);
   }
-
-  system::error_code error;
-  m_impl->m_serial.open(port, error);
-  if (error) {
-    std::cout << "RobotiqGripperInterface::connect failed with error: " << error.message()
-              << "\n";
-    return m_impl->is_connected;
+  m_impl->record_pending_command();
+  m_impl->m_shadow.invalidate();
+  m_impl->m_ring.clear();
+  m_impl->m_transport = std::move(transport);
+  m_impl->m_master.set_transport(m_impl->m_transport.get());
+  m_impl->is_connected = m_impl->m_transport != nullptr;
+  if (not m_impl->is_connected) {
+    return ErrorCode::PORT_ERROR;
   }
-
-  m_impl->is_connected = true;
-  m_impl->m_serial.set_option(asio::serial_port_base::baud_rate(baud));
-  m_impl->m_serial.set_option(asio::serial_port_base::character_size(8));
-  m_impl->m_serial.set_option(
-      asio::serial_port_base::stop_bits(asio::serial_port_base::stop_bits::one));
-  m_impl->m_serial.set_option(
-      asio::serial_port_base::parity(asio::serial_port_base::parity::none));
-  return m_impl->is_connected;
+  return {};
 }
 
-bool RobotiqGripperInterface::reset(bool blocking) {
+Result<void> RobotiqGripperInterface::reset(bool blocking) {
   if (not m_impl->is_connected) {
-    std::cout << "[RobotiqGripperInterface] Warning: reset() ignored since the gripper "
-                 "is not connected\n";
-    return m_impl->is_connected;
+    return ErrorCode::NOT_CONNECTED;
   }
 
-  std::string r = write_read(m_impl->m_serial, PRESET_RESET, m_impl->m_timeout_ms);
-  if (r.compare(PRESET_RESPONSE) != 0) {
-    return false;
+  m_impl->record_pending_command();
+  const RegisterShadow::Registers outputs{};
+  m_impl->m_shadow.sent(OUTPUT_REGISTERS_ADDRESS, outputs.data(), outputs.size());
+  auto sent = MotionModel::Clock::now();
+  ErrorCode error = m_impl->m_master.transact(
+      m_impl->m_preset_reset, m_impl->m_preset_header, PRESET_RESPONSE_BYTES);
+  m_impl->update_outputs(error);
+  m_impl->record(RECORD_COMMAND, m_impl->m_preset_reset.substr(14, 12), sent,
+                 MotionModel::Clock::now(), error == ErrorCode::NONE);
+  if (error != ErrorCode::NONE) {
+    return error;
   }
 
   if (blocking) {
-    bool done = false;
-    while (not done) {
-      GripperFeedback y = get_feedback();
-      done = y.status.gact == ActivationStatus::NOT_ACTIVATED ? true : false;
+    auto deadline = m_impl->motion_deadline();
+    while (true) {
+      Result<GripperFeedback> y = get_feedback();
+      if (not y) {
+        return y.error();
+      }
+      if (y->status.gact == ActivationStatus::NOT_ACTIVATED) {
+        break;
+      }
+      if (MotionModel::Clock::now() > deadline) {
+        return ErrorCode::MOTION_TIMEOUT;
+      }
     }
   }
 
-  return true;
+  return {};
 }
 
-bool RobotiqGripperInterface::is_activated() {
-  if (not m_impl->is_connected) {
-    std::cout
-        << "[RobotiqGripperInterface] Warning: activate() ignored since the gripper "
-           "is not connected\n";
-    return m_impl->is_connected;
+Result<bool> RobotiqGripperInterface::is_activated() {
+  // Feedback read within the cache freshness answers without a transaction
+  RegisterShadow::Registers inputs;
+  auto now = RegisterShadow::Clock::now();
+  if (m_impl->is_connected &&
+      m_impl->m_shadow.fresh_inputs(now, m_impl->m_cache_freshness, inputs)) {
+    ++m_impl->m_cache_stats.cached_reads;
+    return (inputs[0] & GACT_BIT) != 0;
+  }
+  Result<GripperFeedback> y = get_feedback();
+  if (not y) {
+    return y.error();
   }
-  GripperFeedback y = get_feedback();
-  return (y.status.gact == ActivationStatus::ACTIVATED);
+  return y->status.gact == ActivationStatus::ACTIVATED;
 }
 
-bool RobotiqGripperInterface::activate(bool blocking) {
+Result<void> RobotiqGripperInterface::activate(bool blocking) {
   if (not m_impl->is_connected) {
-    std::cout
-        << "[RobotiqGripperInterface] Warning: activate() ignored since the gripper "
-           "is not connected\n";
-    return m_impl->is_connected;
+    return ErrorCode::NOT_CONNECTED;
   }
 
-  std::string r = write_read(m_impl->m_serial, PRESET_ACTIVATE, m_impl->m_timeout_ms);
-  if (r.compare(PRESET_RESPONSE) != 0) {
-    return false;
+  m_impl->record_pending_command();
+  const RegisterShadow::Registers outputs{0x0100, 0, 0};
+  m_impl->m_shadow.sent(OUTPUT_REGISTERS_ADDRESS, outputs.data(), outputs.size());
+  auto sent = MotionModel::Clock::now();
+  ErrorCode error = m_impl->m_master.transact(
+      m_impl->m_preset_activate, m_impl->m_preset_header, PRESET_RESPONSE_BYTES);
+  m_impl->update_outputs(error);
+  m_impl->record(RECORD_COMMAND, m_impl->m_preset_activate.substr(14, 12), sent,
+                 MotionModel::Clock::now(), error == ErrorCode::NONE);
+  if (error != ErrorCode::NONE) {
+    return error;
   }
 
   if (blocking) {
-    bool done = false;
-    while (not done) {
-      GripperFeedback y = get_feedback();
-      done = y.status.gact == ActivationStatus::ACTIVATED ? true : false;
+    auto deadline = m_impl->motion_deadline();
+    while (true) {
+      Result<GripperFeedback> y = get_feedback();
+      if (not y) {
+        return y.error();
+      }
+      if (y->status.gact == ActivationStatus::ACTIVATED) {
+        break;
+      }
+      if (MotionModel::Clock::now() > deadline) {
+        return ErrorCode::MOTION_TIMEOUT;
+      }
     }
+
+    // the activated flag seems to go high early
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(m_impl->m_model.activation_settle_ms));
   }
 
-  // the activated flag seems to go high early
-  std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+  return {};
+}
 
-  return true;
+Result<void> RobotiqGripperInterface::close_gripper(bool blocking) {
+  return set_raw_gripper_position(255, MAX_SPEED, MAX_FORCE, blocking);
 }
 
-bool RobotiqGripperInterface::close_gripper(bool blocking) {
-  return set_raw_gripper_position(255, blocking);
+Result<void> RobotiqGripperInterface::open_gripper(bool blocking) {
+  return set_raw_gripper_position(0, MAX_SPEED, MAX_FORCE, blocking);
 }
 
-bool RobotiqGripperInterface::open_gripper(bool blocking) {
-  return set_raw_gripper_position(0, blocking);
+Result<void> RobotiqGripperInterface::set_gripper_position(double position,
+                                                           bool blocking) {
+  return set_raw_gripper_position(position_to_word(position), MAX_SPEED, MAX_FORCE,
+                                  blocking);
 }
 
-bool RobotiqGripperInterface::set_gripper_position(double position, bool blocking) {
-  return set_raw_gripper_position(position_to_word(position), blocking);
+Result<void> RobotiqGripperInterface::set_gripper_position(double position,
+                                                           double speed, double force,
+                                                           bool blocking) {
+  return set_raw_gripper_position(position_to_word(position), ratio_to_word(speed),
+                                  ratio_to_word(force), blocking);
 }
 
-GripperFeedback RobotiqGripperInterface::get_feedback() {
-  GripperFeedback feedback;
+Result<bool> RobotiqGripperInterface::grasp(const GraspProfile& profile) {
   if (not m_impl->is_connected) {
-    std::cout
-        << "[RobotiqGripperInterface] Warning: get_feedback() ignored since the gripper "
-           "is not connected\n";
-    return feedback;
+    return ErrorCode::NOT_CONNECTED;
   }
 
-  std::string r = write_read(m_impl->m_serial, READ_FEEDBACK, m_impl->m_timeout_ms);
-  if (r.size() != 22) {
-    std::cout << "[RobotiqGripperInterface] Warning: get_feedback() returned an "
-                 "unexpected number of bytes, consider increasing the timeout setting\n";
-    return feedback;
+  // Closing increases the raw word, so the approach ends at the more open of the two
+  // positions at the slowdown margin around the expected width
+  uint8_t contact = position_to_word(profile.expected_width);
+  uint8_t approach =
+      std::min(position_to_word(profile.expected_width + profile.slowdown_margin),
+               position_to_word(profile.expected_width - profile.slowdown_margin));
+
+  // Approach fast, and switch to the slow contact command as the fingers reach the
+  // slowdown margin instead of waiting for them to settle there
+  auto deadline = m_impl->motion_deadline();
+  Result<GripperFeedback> y = get_feedback();
+  if (not y) {
+    return y.error();
+  }
+  if (y->raw_position + APPROACH_TOLERANCE < approach) {
+    Result<void> sent = send_raw_position_command(
+        approach, ratio_to_word(profile.approach_speed),
+        ratio_to_word(profile.approach_force));
+    if (sent) {
+      sent = receive_preset_response();
+    }
+    if (not sent) {
+      return sent.error();
+    }
+    while (true) {
+      y = get_feedback();
+      if (not y) {
+        return y.error();
+      }
+      if (y->raw_commanded_position == approach) {
+        if (y->status.gobj == ObjectStatus::STOPPED_WHILE_CLOSING) {
+          return true;
+        }
+        if (y->raw_position + APPROACH_TOLERANCE >= approach ||
+            y->status.gobj != ObjectStatus::IN_MOTION) {
+          break;
+        }
+        if (m_impl->m_predictive_polling) {
+          std::this_thread::sleep_for(
+              m_impl->m_motion_model.poll_delay(y->raw_position, approach));
+        }
+      }
+      if (MotionModel::Clock::now() > deadline) {
+        return ErrorCode::MOTION_TIMEOUT;
+      }
+    }
   }
 
+  // Close slowly until the fingers stop on the object
+  Result<void> sent = send_raw_position_command(255, ratio_to_word(profile.contact_speed),
+                                                ratio_to_word(profile.contact_force));
+  if (sent) {
+    sent = receive_preset_response();
+  }
+  if (not sent) {
+    return sent.error();
+  }
+  while (true) {
+    y = get_feedback();
+    if (not y) {
+      return y.error();
+    }
+    if (y->raw_commanded_position == 255) {
+      if (y->status.gobj != ObjectStatus::IN_MOTION) {
+        return y->status.gobj == ObjectStatus::STOPPED_WHILE_CLOSING;
+      }
+      if (m_impl->m_predictive_polling) {
+        std::this_thread::sleep_for(
+            m_impl->m_motion_model.poll_delay(y->raw_position, contact));
+      }
+    }
+    if (MotionModel::Clock::now() > deadline) {
+      return ErrorCode::MOTION_TIMEOUT;
+    }
+  }
+}
+
+Result<GripperFeedback> RobotiqGripperInterface::get_feedback() {
+  if (not m_impl->is_connected) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+
+  m_impl->record_pending_command();
+  auto sent = MotionModel::Clock::now();
+  ErrorCode error = m_impl->m_master.transact(
+      m_impl->m_read_feedback, m_impl->m_feedback_header, FEEDBACK_RESPONSE_BYTES);
+  auto completed = MotionModel::Clock::now();
+  const std::string& r = m_impl->m_master.response();
+  bool valid = error == ErrorCode::NONE;
+  m_impl->record(RECORD_FEEDBACK, valid ? r.substr(6, 12) : "", sent, completed, valid);
+  if (not valid) {
+    return error;
+  }
+  RegisterShadow::Registers inputs;
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    inputs[i] = hex_to_uint16(r.substr(6 + 4 * i, 4));
+  }
+  m_impl->m_shadow.received(INPUT_REGISTERS_ADDRESS, inputs.data(), inputs.size(),
+                            completed);
+
+  GripperFeedback feedback;
   // Note: bit masking is derived from the tables in Section 4.4 of the manual.
   unsigned char byte0 = *hex_to_bin(r.substr(6, 2)).c_str();
   feedback.status.gobj = static_cast<ObjectStatus>((byte0 & 0xC0) >> 6);      // bits 7-6
@@ -192,43 +500,7 @@ GripperFeedback RobotiqGripperInterface::get_feedback() {
 
   unsigned byte2 = *hex_to_bin(r.substr(10, 2)).c_str();
   unsigned gflt = static_cast<unsigned>(byte2 & 0x0F);  // bits 3-0
-  switch (gflt) {
-    case 0:
-      feedback.status.gflt = FaultStatus::NONE;
-      break;
-    case 5:
-      feedback.status.gflt = FaultStatus::ACTION_DELAYED;
-      break;
-    case 7:
-      feedback.status.gflt = FaultStatus::ACTIVATION_NEEDED;
-      break;
-    case 8:
-      feedback.status.gflt = FaultStatus::MAX_TEMP_EXCEEDED;
-      break;
-    case 9:
-      feedback.status.gflt = FaultStatus::COMM_TIMEOUT;
-      break;
-    case 10:
-      feedback.status.gflt = FaultStatus::UNDER_VOLTAGE;
-      break;
-    case 11:
-      feedback.status.gflt = FaultStatus::AUTOMATIC_RELEASE_IN_PROGRESS;
-      break;
-    case 12:
-      feedback.status.gflt = FaultStatus::INTERNAL_FAULT;
-      break;
-    case 13:
-      feedback.status.gflt = FaultStatus::ACTIVATION_FAULT;
-      break;
-    case 14:
-      feedback.status.gflt = FaultStatus::OVERCURRENT;
-      break;
-    case 15:
-      feedback.status.gflt = FaultStatus::AUTOMATIC_RELEASE_COMPLETED;
-      break;
-    default:
-      feedback.status.gflt = FaultStatus::UNKNOWN;
-  }
+  feedback.status.gflt = code_to_fault(static_cast<uint8_t>(gflt));
 
   // Access the streaming feedback values
   unsigned byte3 = *hex_to_bin(r.substr(12, 2)).c_str();
@@ -245,51 +517,384 @@ GripperFeedback RobotiqGripperInterface::get_feedback() {
   unsigned cur_fbk = static_cast<unsigned>(byte5 & 0xFF);
   feedback.current = static_cast<double>(cur_fbk) / 255.0;
 
+  // The gripper samples between the end of the request and the start of its response
+  FeedbackTiming& timing = feedback.timing;
+  timing.sent = sent;
+  timing.first_byte = m_impl->m_master.first_byte();
+  timing.completed = completed;
+  int64_t request_bytes = static_cast<int64_t>(m_impl->m_read_feedback.size() / 2);
+  auto request_end = sent + request_bytes * m_impl->m_byte_time;
+  auto response_start = timing.first_byte - m_impl->m_byte_time;
+  timing.sampled = response_start > request_end
+                       ? request_end + (response_start - request_end) / 2
+                       : sent + (timing.first_byte - sent) / 2;
+  m_impl->m_ring.push(feedback);
+
+  m_impl->m_motion_model.update(feedback.raw_position,
+                                feedback.status.gobj == ObjectStatus::IN_MOTION,
+                                completed);
+  m_impl->m_last_feedback = feedback;
+  m_impl->m_publisher.publish(feedback);
+  if (m_impl->m_feedback_callback) {
+    m_impl->m_feedback_callback(feedback);
+  }
+
   return feedback;
 }
 
-void RobotiqGripperInterface::set_timeout(std::size_t timeout_ms) {
-  m_impl->m_timeout_ms = timeout_ms;
+Result<void> RobotiqGripperInterface::read_registers(uint16_t address, uint16_t count,
+                                                     std::vector<uint16_t>& values) {
+  if (not m_impl->is_connected) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+  ErrorCode error = m_impl->m_master.read(RegisterTable::HOLDING, address, count, values);
+  if (error != ErrorCode::NONE) {
+    return error;
+  }
+  m_impl->m_shadow.received(address, values.data(), count, RegisterShadow::Clock::now());
+  return {};
 }
 
-std::size_t RobotiqGripperInterface::get_timeout() const { return m_impl->m_timeout_ms; }
-
-bool RobotiqGripperInterface::set_raw_gripper_position(uint8_t position, bool blocking) {
+Result<void> RobotiqGripperInterface::write_registers(
+    uint16_t address, const std::vector<uint16_t>& values) {
   if (not m_impl->is_connected) {
-    std::cout << "[RobotiqGripperInterface] Warning: set_raw_gripper_position() ignored "
-                 "since the gripper is not connected\n";
-    return m_impl->is_connected;
+    return ErrorCode::NOT_CONNECTED;
+  }
+  if (values.empty() || values.size() > MAX_REGISTER_COUNT) {
+    return ErrorCode::INVALID_ARGUMENT;
+  }
+  m_impl->m_shadow.sent(address, values.data(), values.size());
+  ErrorCode error = m_impl->m_master.write(address, values);
+  m_impl->update_outputs(error);
+  if (error != ErrorCode::NONE) {
+    return error;
   }
+  return {};
+}
+
+void RobotiqGripperInterface::queue_request(RegisterRead& read) {
+  m_impl->m_master.queue(read);
+  m_impl->m_queued.emplace_back(&read, nullptr);
+}
 
-  // Create the message and append the modbus CRC check
-  std::string message =
-      PRESET_POSITION_PREFIX + uint8_to_hex(position) + PRESET_POSITION_POSTFIX;
-  message += crc16_modbus(message);
+void RobotiqGripperInterface::queue_request(RegisterWrite& write) {
+  m_impl->m_master.queue(write);
+  m_impl->m_queued.emplace_back(nullptr, &write);
+}
 
-  if (blocking) {
-    std::string r = write_read(m_impl->m_serial, message, m_impl->m_timeout_ms);
-    if (r.compare(PRESET_RESPONSE) != 0) {
-      return false;
+Result<void> RobotiqGripperInterface::execute_requests() {
+  if (not m_impl->is_connected) {
+    for (auto& request : m_impl->m_queued) {
+      (request.first ? request.first->error : request.second->error) =
+          ErrorCode::NOT_CONNECTED;
+    }
+    m_impl->m_queued.clear();
+    m_impl->m_master.clear();
+    return ErrorCode::NOT_CONNECTED;
+  }
+  ErrorCode error = m_impl->m_master.execute();
+
+  // Replay the outcomes in order into the shadow registers
+  auto now = RegisterShadow::Clock::now();
+  for (auto& request : m_impl->m_queued) {
+    if (request.first && request.first->error == ErrorCode::NONE) {
+      const RegisterRead& read = *request.first;
+      m_impl->m_shadow.received(read.address, read.values.data(), read.count, now);
+    } else if (request.second) {
+      const RegisterWrite& write = *request.second;
+      m_impl->m_shadow.sent(write.address, write.values.data(), write.values.size());
+      m_impl->update_outputs(write.error);
     }
+  }
+  m_impl->m_queued.clear();
+  if (error != ErrorCode::NONE) {
+    return error;
+  }
+  return {};
+}
+
+void RobotiqGripperInterface::set_calibration_path(const std::string& path) {
+  m_impl->m_calibration_path = path;
+}
 
-    bool done = false;
-    while (not done) {
-      GripperFeedback y = get_feedback();
-      done = y.status.gobj == ObjectStatus::IN_MOTION ? false : true;
+bool RobotiqGripperInterface::set_calibration(const Calibration& calibration) {
+  if (not calibration.valid()) {
+    return false;
+  }
+  m_impl->m_calibration = calibration;
+  return true;
+}
+
+Result<void> RobotiqGripperInterface::calibrate(
+    const std::function<double(uint8_t)>& measure, std::size_t points) {
+  if (points < 2) {
+    return ErrorCode::INVALID_ARGUMENT;
+  }
+
+  // The gripper may stop short of a word, so the measurement is at the word reached
+  std::vector<CalibrationPoint> measured;
+  for (std::size_t i = 0; i < points; ++i) {
+    uint8_t word = static_cast<uint8_t>(std::round(255.0 * i / (points - 1)));
+    Result<void> moved = set_raw_gripper_position(word, MAX_SPEED, MAX_FORCE, true);
+    if (not moved) {
+      return moved;
+    }
+    Result<GripperFeedback> y = get_feedback();
+    if (not y) {
+      return y.error();
+    }
+    if (measured.empty() || measured.back().word != y->raw_position) {
+      measured.push_back({y->raw_position, measure(y->raw_position)});
     }
-  } else {
-    write(m_impl->m_serial, message);
   }
-  
+
+  Calibration calibration;
+  if (not calibration.build(measured)) {
+    return ErrorCode::INVALID_ARGUMENT;
+  }
+  m_impl->m_calibration = calibration;
+  if (not m_impl->m_calibration_path.empty() &&
+      not calibration.save(m_impl->m_calibration_path)) {
+    return ErrorCode::FILE_ERROR;
+  }
+  return {};
+}
+
+void RobotiqGripperInterface::set_slave_id(uint8_t slave_id) {
+  m_impl->set_slave_id(slave_id);
+}
+
+uint8_t RobotiqGripperInterface::get_slave_id() const { return m_impl->m_slave_id; }
+
+void RobotiqGripperInterface::set_serial_options(const SerialOptions& options) {
+  m_impl->m_serial_options = options;
+}
+
+SerialLatencyReport RobotiqGripperInterface::get_serial_report() const {
+  return m_impl->m_serial_report;
+}
+
+void RobotiqGripperInterface::set_timeout(std::size_t timeout_ms) {
+  m_impl->m_master.set_timeout(timeout_ms);
+}
+
+std::size_t RobotiqGripperInterface::get_timeout() const {
+  return m_impl->m_master.timeout();
+}
+
+void RobotiqGripperInterface::set_motion_timeout(std::size_t timeout_ms) {
+  m_impl->m_motion_timeout_ms = timeout_ms;
+}
+
+std::size_t RobotiqGripperInterface::get_motion_timeout() const {
+  return m_impl->m_motion_timeout_ms;
+}
+
+void RobotiqGripperInterface::set_cache_freshness(std::size_t freshness_ms) {
+  m_impl->m_cache_freshness = std::chrono::milliseconds(freshness_ms);
+}
+
+std::size_t RobotiqGripperInterface::get_cache_freshness() const {
+  return static_cast<std::size_t>(m_impl->m_cache_freshness.count());
+}
+
+RegisterCacheStats RobotiqGripperInterface::get_cache_stats() const {
+  RegisterCacheStats stats = m_impl->m_cache_stats;
+  stats.transactions = m_impl->m_master.transactions();
+  stats.merged_reads = m_impl->m_master.merged_reads();
+  return stats;
+}
+
+double RobotiqGripperInterface::estimated_time_to_target() const {
+  const GripperFeedback& y = m_impl->m_last_feedback;
+  if (y.status.gobj != ObjectStatus::IN_MOTION) {
+    return 0;
+  }
+  return m_impl->m_motion_model.time_to_target(y.raw_position, y.raw_commanded_position);
+}
+
+bool RobotiqGripperInterface::position_at(std::chrono::steady_clock::time_point time,
+                                          double& position) const {
+  double word;
+  if (not m_impl->m_ring.word_at(time, word)) {
+    return false;
+  }
+  // Interpolate between the positions of the words around, which may be calibrated
+  uint8_t below = static_cast<uint8_t>(std::floor(word));
+  uint8_t above = below < 255 ? static_cast<uint8_t>(below + 1) : below;
+  double low = word_to_position(below);
+  position = low + (word - below) * (word_to_position(above) - low);
   return true;
 }
 
+FeedbackSpans RobotiqGripperInterface::get_feedback_history(std::size_t count) const {
+  return m_impl->m_ring.last(count);
+}
+
+FeedbackSpans RobotiqGripperInterface::get_feedback_history(
+    std::chrono::steady_clock::time_point from,
+    std::chrono::steady_clock::time_point to) const {
+  return m_impl->m_ring.window(from, to);
+}
+
+void RobotiqGripperInterface::set_predictive_polling(bool enabled) {
+  m_impl->m_predictive_polling = enabled;
+}
+
+bool RobotiqGripperInterface::record_telemetry(const std::string& path) {
+  m_impl->record_pending_command();
+  return m_impl->m_recorder.open(path);
+}
+
+bool RobotiqGripperInterface::publish_feedback(const std::string& name,
+                                               uint32_t mode) {
+  return m_impl->m_publisher.open(name, mode);
+}
+
+void RobotiqGripperInterface::set_feedback_callback(
+    std::function<void(const GripperFeedback&)> callback) {
+  m_impl->m_feedback_callback = std::move(callback);
+}
+
+std::size_t RobotiqGripperInterface::process_shared_commands() {
+  std::size_t count = 0;
+  shm::Command command;
+  while (m_impl->m_publisher.pop(command)) {
+    switch (command.type) {
+      case shm::COMMAND_RESET:
+        reset(false);
+        break;
+      case shm::COMMAND_ACTIVATE:
+        activate(false);
+        break;
+      case shm::COMMAND_OPEN:
+        open_gripper(false);
+        break;
+      case shm::COMMAND_CLOSE:
+        close_gripper(false);
+        break;
+      case shm::COMMAND_POSITION:
+        set_gripper_position(command.position, false);
+        break;
+    }
+    ++count;
+  }
+  return count;
+}
+
+Result<void> RobotiqGripperInterface::set_raw_gripper_position(uint8_t position,
+                                                               uint8_t speed,
+                                                               uint8_t force,
+                                                               bool blocking) {
+  if (not m_impl->is_connected) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+
+  Result<void> sent = send_raw_position_command(position, speed, force);
+  if (not sent || not blocking) {
+    return sent;
+  }
+
+  Result<void> received = receive_preset_response();
+  if (not received) {
+    return received;
+  }
+
+  // Sleep between polls based on the predicted arrival time of the fingers
+  auto deadline = m_impl->motion_deadline();
+  while (true) {
+    Result<GripperFeedback> y = get_feedback();
+    if (not y) {
+      return y.error();
+    }
+    if (y->status.gobj != ObjectStatus::IN_MOTION) {
+      return {};
+    }
+    if (MotionModel::Clock::now() > deadline) {
+      return ErrorCode::MOTION_TIMEOUT;
+    }
+    if (m_impl->m_predictive_polling) {
+      std::this_thread::sleep_for(
+          m_impl->m_motion_model.poll_delay(y->raw_position, position));
+    }
+  }
+}
+
+Result<void> RobotiqGripperInterface::send_raw_position_command(uint8_t position,
+                                                                uint8_t speed,
+                                                                uint8_t force) {
+  if (not m_impl->is_connected) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+  m_impl->record_pending_command();
+
+  // The response to a skipped command is not awaited
+  const RegisterShadow::Registers outputs{0x0900, position,
+                                          static_cast<uint16_t>(speed << 8 | force)};
+  auto sent = MotionModel::Clock::now();
+  m_impl->m_command_skipped =
+      m_impl->m_shadow.is_redundant(outputs, sent, m_impl->m_cache_freshness);
+  if (m_impl->m_command_skipped) {
+    ++m_impl->m_cache_stats.skipped_writes;
+    return {};
+  }
+
+  std::string message = m_impl->position_message(position, speed, force);
+  m_impl->m_shadow.sent(OUTPUT_REGISTERS_ADDRESS, outputs.data(), outputs.size());
+  ErrorCode error = m_impl->m_master.send(message);
+  if (error != ErrorCode::NONE) {
+    m_impl->m_shadow.invalidate_outputs();
+    return error;
+  }
+
+  // Recorded once the response is received, or without it before the next transaction
+  if (m_impl->m_recorder.is_open()) {
+    m_impl->m_pending_command =
+        make_sample(RECORD_COMMAND, message.substr(14, 12), sent, sent, false);
+    m_impl->m_has_pending_command = true;
+  }
+  m_impl->m_motion_model.reset_segment();
+  m_impl->m_motion_model.set_speed(speed);
+  return {};
+}
+
+Result<void> RobotiqGripperInterface::receive_preset_response() {
+  if (not m_impl->is_connected) {
+    return ErrorCode::NOT_CONNECTED;
+  }
+  if (m_impl->m_command_skipped) {
+    m_impl->m_command_skipped = false;
+    return {};
+  }
+  ErrorCode error =
+      m_impl->m_master.receive(m_impl->m_preset_header, PRESET_RESPONSE_BYTES);
+  m_impl->update_outputs(error);
+  m_impl->record_command_response(error == ErrorCode::NONE);
+  if (error != ErrorCode::NONE) {
+    return error;
+  }
+  return {};
+}
+
+void RobotiqGripperInterface::set_model_parameters(const ModelParameters& parameters) {
+  m_impl->m_model = parameters;
+  m_impl->m_motion_model.configure(parameters.full_stroke_time_s,
+                                   parameters.min_speed_ratio);
+}
+
 double RobotiqGripperInterface::word_to_position(uint8_t word) const {
-  return (m_impl->m_scale_alpha / 255.0) * static_cast<double>(word) + m_impl->m_scale_beta;
+  if (m_impl->m_calibration.valid()) {
+    return m_impl->m_calibration.to_position(word);
+  }
+  return m_impl->m_position_per_word * static_cast<double>(word) + m_impl->m_scale_beta;
 }
 
 uint8_t RobotiqGripperInterface::position_to_word(double position) const {
-  double scaled_position = 255.0 / m_impl->m_scale_alpha * (position - m_impl->m_scale_beta);
+  if (m_impl->m_calibration.valid()) {
+    return m_impl->m_calibration.to_word(position);
+  }
+  double scaled_position =
+      m_impl->m_word_per_position * (position - m_impl->m_scale_beta);
   scaled_position = std::max(scaled_position, 0.0);
   scaled_position = std::min(scaled_position, 255.0);
   return static_cast<uint8_t>(scaled_position);
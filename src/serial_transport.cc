@@ -0,0 +1,156 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/transport.h"
+#include "src/timeout_reader.h"
+
+#include <sys/ioctl.h>
+#include <termios.h>
+
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
+#include <boost/asio.hpp>
+
+using namespace boost;
+
+namespace robotiq {
+
+struct SerialTransport::Implementation {
+  Implementation();
+  asio::io_service m_io_service;
+  asio::serial_port m_serial;
+  SerialLatencyReport m_report;
+};
+
+// Switches the port to raw mode, where a read returns as soon as one byte arrived
+static bool set_raw_termios(int fd) {
+  termios tty;
+  if (::tcgetattr(fd, &tty) != 0) {
+    return false;
+  }
+  ::cfmakeraw(&tty);
+  tty.c_cflag |= CLOCAL | CREAD;
+  tty.c_cc[VMIN] = 1;
+  tty.c_cc[VTIME] = 0;
+  return ::tcsetattr(fd, TCSANOW, &tty) == 0;
+}
+
+// Asks the driver to push received bytes immediately, e.g. FTDI adapters otherwise hold
+// them up to their 16 ms latency timer.  Returns true if the flag reads back as set.
+static bool set_low_latency_flag(int fd) {
+#if defined(__linux__) && defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  serial_struct serial;
+  if (::ioctl(fd, TIOCGSERIAL, &serial) != 0) {
+    return false;
+  }
+  serial.flags |= ASYNC_LOW_LATENCY;
+  if (::ioctl(fd, TIOCSSERIAL, &serial) != 0 || ::ioctl(fd, TIOCGSERIAL, &serial) != 0) {
+    return false;
+  }
+  return (serial.flags & ASYNC_LOW_LATENCY) != 0;
+#else
+  (void)fd;
+  return false;
+#endif
+}
+
+// Lets the kernel drive the transceiver direction with RTS, on UARTs that support it.
+// The RTS polarity and delays are kept as configured for the board, e.g. by the device
+// tree, since they depend on how the transceiver is wired.
+static bool set_rs485(int fd) {
+#if defined(__linux__) && defined(TIOCGRS485)
+  serial_rs485 rs485;
+  if (::ioctl(fd, TIOCGRS485, &rs485) != 0) {
+    return false;
+  }
+  rs485.flags |= SER_RS485_ENABLED;
+  return ::ioctl(fd, TIOCSRS485, &rs485) == 0;
+#else
+  (void)fd;
+  return false;
+#endif
+}
+
+SerialTransport::Implementation::Implementation() : m_serial(m_io_service) {}
+
+SerialTransport::SerialTransport() : m_impl{std::make_unique<Implementation>()} {}
+
+SerialTransport::~SerialTransport() {
+  if (m_impl->m_serial.is_open()) {
+    m_impl->m_serial.close();
+  }
+}
+
+bool SerialTransport::open(const std::string& port, std::size_t baud,
+                           std::string& error, const SerialOptions& options) {
+  if (m_impl->m_serial.is_open()) {
+    m_impl->m_serial.close();
+  }
+  m_impl->m_report = SerialLatencyReport{};
+
+  system::error_code error_code;
+  m_impl->m_serial.open(port, error_code);
+  if (error_code) {
+    error = error_code.message();
+    return false;
+  }
+
+  m_impl->m_serial.set_option(asio::serial_port_base::baud_rate(baud));
+  m_impl->m_serial.set_option(asio::serial_port_base::character_size(8));
+  m_impl->m_serial.set_option(
+      asio::serial_port_base::stop_bits(asio::serial_port_base::stop_bits::one));
+  m_impl->m_serial.set_option(
+      asio::serial_port_base::parity(asio::serial_port_base::parity::none));
+
+  // Each setting is independent, so an unsupported one is skipped without failing
+  if (options.low_latency) {
+    int fd = m_impl->m_serial.native_handle();
+    SerialLatencyReport& report = m_impl->m_report;
+    report.raw_termios = set_raw_termios(fd);
+    report.low_latency = set_low_latency_flag(fd);
+    report.rs485 = options.rs485 && set_rs485(fd);
+    report.flushed = ::tcflush(fd, TCIOFLUSH) == 0;
+  }
+  return true;
+}
+
+const SerialLatencyReport& SerialTransport::latency_report() const {
+  return m_impl->m_report;
+}
+
+std::string to_string(const SerialLatencyReport& report) {
+  auto yes_no = [](bool value) { return value ? "yes" : "no"; };
+  return std::string("raw_termios=") + yes_no(report.raw_termios) +
+         " low_latency=" + yes_no(report.low_latency) + " rs485=" + yes_no(report.rs485) +
+         " flushed=" + yes_no(report.flushed);
+}
+
+bool SerialTransport::write(const std::string& bytes) {
+  system::error_code error;
+  asio::write(m_impl->m_serial, asio::buffer(bytes.data(), bytes.size()), error);
+  return not error;
+}
+
+bool SerialTransport::read_byte(char& c, std::size_t timeout_ms) {
+  TimeoutReader reader(m_impl->m_serial, timeout_ms);
+  return reader.read_char(c);
+}
+
+void SerialTransport::flush_input() {
+  ::tcflush(m_impl->m_serial.native_handle(), TCIFLUSH);
+}
+
+}  // namespace robotiq
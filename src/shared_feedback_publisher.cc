@@ -0,0 +1,84 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/shared_feedback_publisher.h"
+
+#include <chrono>
+
+namespace robotiq {
+
+SharedFeedbackPublisher::~SharedFeedbackPublisher() { close(); }
+
+bool SharedFeedbackPublisher::open(const std::string& name, uint32_t mode) {
+  close();
+
+  // Start from a fresh segment so stale readers of a previous owner are not reused
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, static_cast<mode_t>(mode));
+  if (fd < 0) {
+    return false;
+  }
+  // The umask applies at creation, set the mode exactly so that a group can be allowed
+  if (fchmod(fd, static_cast<mode_t>(mode)) != 0) {
+    ::close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+  if (ftruncate(fd, sizeof(shm::Segment)) != 0) {
+    ::close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+  void* address =
+      mmap(nullptr, sizeof(shm::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  m_name = name;
+  m_segment = static_cast<shm::Segment*>(address);
+  m_next_index = 0;
+  shm::initialize(*m_segment);
+  return true;
+}
+
+void SharedFeedbackPublisher::close() {
+  if (m_segment == nullptr) {
+    return;
+  }
+  munmap(m_segment, sizeof(shm::Segment));
+  shm_unlink(m_name.c_str());
+  m_segment = nullptr;
+}
+
+void SharedFeedbackPublisher::publish(const GripperFeedback& feedback) {
+  if (m_segment == nullptr) {
+    return;
+  }
+  shm::Sample sample;
+  sample.index = m_next_index++;
+  sample.stamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+  sample.feedback = feedback;
+  shm::write_slot(*m_segment, sample);
+}
+
+bool SharedFeedbackPublisher::pop(shm::Command& command) {
+  return m_segment != nullptr && shm::pop_command(*m_segment, command);
+}
+
+}  // namespace robotiq
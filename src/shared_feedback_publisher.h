@@ -0,0 +1,49 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "robotiq/shared_feedback.h"
+
+namespace robotiq {
+
+/** Owns the shared memory segment that feedback is published to */
+class SharedFeedbackPublisher {
+ public:
+  SharedFeedbackPublisher() = default;
+  SharedFeedbackPublisher(const SharedFeedbackPublisher&) = delete;
+  SharedFeedbackPublisher& operator=(const SharedFeedbackPublisher&) = delete;
+  ~SharedFeedbackPublisher();
+
+  /** Creates (or recreates) and maps the named segment with permissions, e.g. 0600 */
+  bool open(const std::string& name, uint32_t mode = DEFAULT_SHARED_FEEDBACK_MODE);
+
+  /** Unmaps and unlinks the segment */
+  void close();
+
+  /** Appends a feedback sample to the ring */
+  void publish(const GripperFeedback& feedback);
+
+  /** Takes the next pending command, returns false if there is none */
+  bool pop(shm::Command& command);
+
+ private:
+  std::string m_name;
+  shm::Segment* m_segment{nullptr};
+  uint64_t m_next_index{0};
+};
+
+}  // namespace robotiq
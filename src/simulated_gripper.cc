@@ -0,0 +1,245 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/simulation.h"
+#include "src/helpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace robotiq {
+
+// First output and input registers (4.1 of the manual)
+static const uint16_t OUTPUT_REGISTERS = 0x03E8;
+static const uint16_t INPUT_REGISTERS = 0x07D0;
+static const uint16_t REGISTER_COUNT = 3;
+
+// Function codes
+static const uint8_t FC_READ_HOLDING_REGISTERS = 0x03;
+static const uint8_t FC_READ_INPUT_REGISTERS = 0x04;
+static const uint8_t FC_PRESET_SINGLE_REGISTER = 0x06;
+static const uint8_t FC_PRESET_MULTIPLE_REGISTERS = 0x10;
+
+// Exception codes
+static const uint8_t ILLEGAL_FUNCTION = 0x01;
+static const uint8_t ILLEGAL_DATA_ADDRESS = 0x02;
+
+// Bits of the action request register
+static const uint8_t ACTION_ACTIVATE = 0x01;
+static const uint8_t ACTION_GOTO = 0x08;
+
+// gOBJ values
+static const uint8_t OBJECT_IN_MOTION = 0;
+static const uint8_t OBJECT_STOPPED_WHILE_CLOSING = 2;
+static const uint8_t OBJECT_AT_REQUESTED_POSITION = 3;
+
+// Bits on the wire per byte with 8 data bits, 1 start and 1 stop bit
+static const double BITS_PER_BYTE = 10;
+
+// Returns the register at an offset of a binary message
+static uint16_t word_at(const std::string& bin, std::size_t offset) {
+  return static_cast<uint16_t>((static_cast<uint8_t>(bin[offset]) << 8) |
+                               static_cast<uint8_t>(bin[offset + 1]));
+}
+
+// Appends the modbus CRC to a hexadecimal message
+static std::string with_crc(const std::string& message) {
+  return message + crc16_modbus(message);
+}
+
+// Creates an exception response
+static std::string exception_response(uint8_t slave_id, uint8_t function, uint8_t code) {
+  return with_crc(uint8_to_hex(slave_id) + uint8_to_hex(function | 0x80) +
+                  uint8_to_hex(code));
+}
+
+SimulatedGripper::SimulatedGripper(const SimulatedGripperConfig& config)
+    : m_config(config),
+      m_byte_time(static_cast<int64_t>(BITS_PER_BYTE * 1e9 / config.baud)),
+      m_last_update(Clock::now()) {}
+
+bool SimulatedGripper::write(const std::string& bytes) {
+  auto now = Clock::now();
+  std::string request = bin_to_hex(bytes);
+  if (bytes.size() < 4 || static_cast<uint8_t>(bytes[0]) != m_config.slave_id ||
+      not has_valid_crc(request)) {
+    return true;
+  }
+
+  std::string response = hex_to_bin(respond(request, now));
+  ++m_requests;
+
+  // The response starts once the request was transmitted and the gripper turned around
+  auto stamp = now + bytes.size() * m_byte_time +
+               std::chrono::microseconds(m_config.turnaround_us);
+  for (char c : response) {
+    stamp += m_byte_time;
+    m_pending.emplace_back(stamp, c);
+  }
+  return true;
+}
+
+bool SimulatedGripper::read_byte(char& c, std::size_t timeout_ms) {
+  auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+  if (m_pending.empty() || m_pending.front().first > deadline) {
+    std::this_thread::sleep_until(deadline);
+    return false;
+  }
+  std::this_thread::sleep_until(m_pending.front().first);
+  c = m_pending.front().second;
+  m_pending.pop_front();
+  return true;
+}
+
+void SimulatedGripper::flush_input() { m_pending.clear(); }
+
+void SimulatedGripper::set_fault(FaultStatus fault) { m_fault = fault_to_code(fault); }
+
+void SimulatedGripper::set_object(int raw_position) {
+  update(Clock::now());
+  m_object = raw_position;
+
+  // A held object that slips or disappears lets the fingers close further
+  if (not m_moving && m_object_status == OBJECT_STOPPED_WHILE_CLOSING &&
+      (m_object < 0 || m_object > m_position)) {
+    m_moving = true;
+    m_object_status = OBJECT_IN_MOTION;
+  }
+}
+
+uint8_t SimulatedGripper::raw_position() {
+  update(Clock::now());
+  return static_cast<uint8_t>(m_position + 0.5);
+}
+
+void SimulatedGripper::update(Clock::time_point now) {
+  double dt = std::chrono::duration<double>(now - m_last_update).count();
+  m_last_update = now;
+  bool activated = (m_action & ACTION_ACTIVATE) && now >= m_activation_done;
+  if (not m_moving || not activated || not(m_action & ACTION_GOTO)) {
+    return;
+  }
+
+  double ratio =
+      m_config.min_speed_ratio + (1.0 - m_config.min_speed_ratio) * m_speed / 255.0;
+  double step = 255.0 / m_config.full_stroke_time_s * ratio * dt;
+  double target = m_position_request;
+  if (m_object >= 0 && m_position <= m_object && target > m_object) {
+    target = m_object;
+  }
+
+  if (std::abs(target - m_position) <= step) {
+    m_position = target;
+    m_moving = false;
+    m_object_status = target == m_position_request ? OBJECT_AT_REQUESTED_POSITION
+                                                   : OBJECT_STOPPED_WHILE_CLOSING;
+  } else {
+    m_position += target > m_position ? step : -step;
+  }
+}
+
+std::string SimulatedGripper::respond(const std::string& request, Clock::time_point now) {
+  update(now);
+  std::string bin = hex_to_bin(request);
+  uint8_t function = static_cast<uint8_t>(bin[1]);
+
+  // Output registers as transmitted: action request, reserved, reserved, position,
+  // speed and force
+  uint8_t outputs[6] = {m_action, 0, 0, m_position_request, m_speed, m_force};
+  std::size_t first = 0;
+  std::size_t count = 0;
+  // The gripper serves its registers to both register reads
+  bool is_read =
+      function == FC_READ_HOLDING_REGISTERS || function == FC_READ_INPUT_REGISTERS;
+  if (is_read || function == FC_PRESET_MULTIPLE_REGISTERS) {
+    if (bin.size() < 8) {
+      return exception_response(m_config.slave_id, function, ILLEGAL_FUNCTION);
+    }
+    first = word_at(bin, 2);
+    count = word_at(bin, 4);
+  } else if (function == FC_PRESET_SINGLE_REGISTER && bin.size() >= 8) {
+    first = word_at(bin, 2);
+    count = 1;
+  } else {
+    return exception_response(m_config.slave_id, function, ILLEGAL_FUNCTION);
+  }
+
+  if (is_read) {
+    std::string registers;
+    if (first >= INPUT_REGISTERS && first + count <= INPUT_REGISTERS + REGISTER_COUNT) {
+      registers = input_registers(now).substr(4 * (first - INPUT_REGISTERS), 4 * count);
+    } else if (first >= OUTPUT_REGISTERS &&
+               first + count <= OUTPUT_REGISTERS + REGISTER_COUNT) {
+      registers = bin_to_hex(std::string(outputs, outputs + 6))
+                      .substr(4 * (first - OUTPUT_REGISTERS), 4 * count);
+    } else {
+      return exception_response(m_config.slave_id, function, ILLEGAL_DATA_ADDRESS);
+    }
+    return with_crc(request.substr(0, 4) + uint8_to_hex(static_cast<uint8_t>(2 * count)) +
+                    registers);
+  }
+
+  // Preset single or multiple output registers
+  std::size_t data = function == FC_PRESET_SINGLE_REGISTER ? 4 : 7;
+  if (first < OUTPUT_REGISTERS || first + count > OUTPUT_REGISTERS + REGISTER_COUNT ||
+      bin.size() < data + 2 * count + 2) {
+    return exception_response(m_config.slave_id, function, ILLEGAL_DATA_ADDRESS);
+  }
+  std::copy(bin.begin() + data, bin.begin() + data + 2 * count,
+            outputs + 2 * (first - OUTPUT_REGISTERS));
+
+  uint8_t previous_action = m_action;
+  m_action = outputs[0];
+  m_position_request = outputs[3];
+  m_speed = outputs[4];
+  m_force = outputs[5];
+  if (not(m_action & ACTION_ACTIVATE)) {
+    m_moving = false;
+  } else if (not(previous_action & ACTION_ACTIVATE)) {
+    m_activation_done = now + std::chrono::milliseconds(m_config.activation_time_ms);
+  }
+  if ((m_action & ACTION_ACTIVATE) && (m_action & ACTION_GOTO)) {
+    m_moving = true;
+    m_object_status = OBJECT_IN_MOTION;
+  }
+  return with_crc(request.substr(0, 12));
+}
+
+std::string SimulatedGripper::input_registers(Clock::time_point now) {
+  // Gripper status: gOBJ, gSTA, gGTO and gACT (4.4 of the manual)
+  uint8_t status = 0;
+  if (m_action & ACTION_ACTIVATE) {
+    bool activated = now >= m_activation_done;
+    status |= activated ? (0x03 << 4) | 0x01 : (0x01 << 4);
+    status |= m_action & ACTION_GOTO;
+    if (activated && not m_moving) {
+      status |= m_object_status << 6;
+    }
+  }
+
+  // The motor current rises while moving and while squeezing an object
+  uint8_t current = 0;
+  if (m_moving) {
+    current = 10;
+  } else if (m_object_status == OBJECT_STOPPED_WHILE_CLOSING) {
+    current = static_cast<uint8_t>(m_force / 2);
+  }
+
+  uint8_t registers[6] = {status, 0, m_fault, m_position_request,
+                          static_cast<uint8_t>(m_position + 0.5), current};
+  return bin_to_hex(std::string(registers, registers + 6));
+}
+
+}  // namespace robotiq
@@ -0,0 +1,141 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/telemetry.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace robotiq {
+
+TelemetryReader::~TelemetryReader() { close(); }
+
+bool TelemetryReader::open(const std::string& path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(TELEMETRY_HEADER_SIZE)) {
+    ::close(fd);
+    return false;
+  }
+  void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+  m_data = static_cast<const uint8_t*>(address);
+  m_length = info.st_size;
+
+  const TelemetryFileHeader& file_header = header();
+  if (file_header.magic != TELEMETRY_MAGIC || file_header.version != TELEMETRY_VERSION ||
+      file_header.block_size != TELEMETRY_BLOCK_SIZE ||
+      file_header.record_size != sizeof(TelemetryRecord)) {
+    close();
+    return false;
+  }
+
+  // Index the blocks from their headers only
+  std::size_t blocks = (m_length - TELEMETRY_HEADER_SIZE) / TELEMETRY_BLOCK_SIZE;
+  for (std::size_t i = 0; i < blocks; ++i) {
+    const TelemetryBlockHeader& header = block(i);
+    if (header.magic != TELEMETRY_BLOCK_MAGIC ||
+        header.count > TELEMETRY_RECORDS_PER_BLOCK) {
+      break;
+    }
+    m_block_starts.push_back(m_size);
+    m_size += header.count;
+  }
+  return true;
+}
+
+void TelemetryReader::close() {
+  if (m_data != nullptr) {
+    munmap(const_cast<uint8_t*>(m_data), m_length);
+  }
+  m_data = nullptr;
+  m_length = 0;
+  m_block_starts.clear();
+  m_size = 0;
+}
+
+const TelemetryFileHeader& TelemetryReader::header() const {
+  return *reinterpret_cast<const TelemetryFileHeader*>(m_data);
+}
+
+const TelemetryBlockHeader& TelemetryReader::block(std::size_t index) const {
+  return *reinterpret_cast<const TelemetryBlockHeader*>(
+      m_data + TELEMETRY_HEADER_SIZE + index * TELEMETRY_BLOCK_SIZE);
+}
+
+TelemetrySample TelemetryReader::at(std::size_t index) const {
+  std::size_t block_index =
+      std::upper_bound(m_block_starts.begin(), m_block_starts.end(), index) -
+      m_block_starts.begin() - 1;
+  const TelemetryBlockHeader& block_header = block(block_index);
+
+  TelemetryRecord record;
+  std::memcpy(&record,
+              reinterpret_cast<const uint8_t*>(&block_header) +
+                  sizeof(TelemetryBlockHeader) +
+                  (index - m_block_starts[block_index]) * sizeof(TelemetryRecord),
+              sizeof(record));
+
+  TelemetrySample sample;
+  sample.stamp_ns = block_header.base_ns + int64_t(record.offset_us) * 1000;
+  sample.latency_us = record.latency_us;
+  sample.type = record.type;
+  sample.flags = record.flags;
+  std::memcpy(sample.registers, record.registers, sizeof(sample.registers));
+  return sample;
+}
+
+std::size_t TelemetryReader::seek(int64_t stamp_ns) const {
+  // Find the last block starting at or before the time, then search its records
+  std::size_t low = 0;
+  std::size_t high = m_block_starts.size();
+  while (low < high) {
+    std::size_t middle = (low + high) / 2;
+    if (block(middle).base_ns <= stamp_ns) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == 0) {
+    return 0;
+  }
+
+  std::size_t first = m_block_starts[low - 1];
+  std::size_t last = first + block(low - 1).count;
+  while (first < last) {
+    std::size_t middle = (first + last) / 2;
+    if (at(middle).stamp_ns < stamp_ns) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return first;
+}
+
+}  // namespace robotiq
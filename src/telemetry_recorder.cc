@@ -0,0 +1,172 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/telemetry_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace robotiq {
+
+// Number of samples the ring can hold, about 20 s of feedback at 200 Hz (power of two)
+static const std::size_t RING_CAPACITY = 4096;
+
+// Period at which the flush thread drains the ring
+static const std::chrono::milliseconds FLUSH_PERIOD(10);
+
+TelemetryRecorder::TelemetryRecorder() : m_ring(RING_CAPACITY) {}
+
+TelemetryRecorder::~TelemetryRecorder() { close(); }
+
+bool TelemetryRecorder::open(const std::string& path) {
+  close();
+
+  m_fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+  if (m_fd < 0) {
+    return false;
+  }
+
+  TelemetryFileHeader header{};
+  header.magic = TELEMETRY_MAGIC;
+  header.version = TELEMETRY_VERSION;
+  header.block_size = TELEMETRY_BLOCK_SIZE;
+  header.record_size = sizeof(TelemetryRecord);
+  header.start_steady_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count();
+  header.start_system_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+  if (ftruncate(m_fd, TELEMETRY_HEADER_SIZE) != 0 ||
+      pwrite(m_fd, &header, sizeof(header), 0) != sizeof(header)) {
+    ::close(m_fd);
+    m_fd = -1;
+    return false;
+  }
+
+  m_blocks = 0;
+  m_head = 0;
+  m_tail = 0;
+  m_dropped = 0;
+  m_running = true;
+  m_thread = std::thread(&TelemetryRecorder::run, this);
+  return true;
+}
+
+void TelemetryRecorder::close() {
+  if (m_fd < 0) {
+    return;
+  }
+  m_running = false;
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+  drain();
+  unmap_block();
+  ::close(m_fd);
+  m_fd = -1;
+}
+
+void TelemetryRecorder::record(const TelemetrySample& sample) {
+  if (not m_running.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::size_t head = m_head.load(std::memory_order_relaxed);
+  if (head - m_tail.load(std::memory_order_acquire) == RING_CAPACITY) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  m_ring[head % RING_CAPACITY] = sample;
+  m_head.store(head + 1, std::memory_order_release);
+}
+
+void TelemetryRecorder::run() {
+  while (m_running.load(std::memory_order_relaxed)) {
+    drain();
+    std::this_thread::sleep_for(FLUSH_PERIOD);
+  }
+}
+
+void TelemetryRecorder::drain() {
+  std::size_t tail = m_tail.load(std::memory_order_relaxed);
+  std::size_t head = m_head.load(std::memory_order_acquire);
+  for (; tail != head; ++tail) {
+    if (not append(m_ring[tail % RING_CAPACITY])) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  m_tail.store(tail, std::memory_order_release);
+}
+
+bool TelemetryRecorder::append(const TelemetrySample& sample) {
+  auto header = reinterpret_cast<TelemetryBlockHeader*>(m_block);
+
+  // Start a new block when the current one is full or its offsets would overflow
+  if (header == nullptr || header->count == TELEMETRY_RECORDS_PER_BLOCK ||
+      sample.stamp_ns - header->base_ns > int64_t(UINT32_MAX) * 1000) {
+    if (not map_next_block(sample.stamp_ns)) {
+      return false;
+    }
+    header = reinterpret_cast<TelemetryBlockHeader*>(m_block);
+  }
+
+  TelemetryRecord record{};
+  int64_t offset_ns = std::max<int64_t>(sample.stamp_ns - header->base_ns, 0);
+  record.offset_us = static_cast<uint32_t>(offset_ns / 1000);
+  record.latency_us = static_cast<uint16_t>(std::min<uint32_t>(sample.latency_us, 65535));
+  record.type = sample.type;
+  record.flags = sample.flags;
+  std::memcpy(record.registers, sample.registers, sizeof(record.registers));
+
+  uint8_t* records = m_block + sizeof(TelemetryBlockHeader);
+  std::memcpy(records + header->count * sizeof(record), &record, sizeof(record));
+  header->count += 1;
+  return true;
+}
+
+bool TelemetryRecorder::map_next_block(int64_t base_ns) {
+  unmap_block();
+  off_t offset = TELEMETRY_HEADER_SIZE + m_blocks * TELEMETRY_BLOCK_SIZE;
+  if (ftruncate(m_fd, offset + TELEMETRY_BLOCK_SIZE) != 0) {
+    return false;
+  }
+  void* address = mmap(nullptr, TELEMETRY_BLOCK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       m_fd, offset);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+  m_block = static_cast<uint8_t*>(address);
+  ++m_blocks;
+
+  TelemetryBlockHeader header{};
+  header.magic = TELEMETRY_BLOCK_MAGIC;
+  header.count = 0;
+  header.base_ns = base_ns;
+  std::memcpy(m_block, &header, sizeof(header));
+  return true;
+}
+
+void TelemetryRecorder::unmap_block() {
+  if (m_block != nullptr) {
+    munmap(m_block, TELEMETRY_BLOCK_SIZE);
+    m_block = nullptr;
+  }
+}
+
+}  // namespace robotiq
@@ -0,0 +1,71 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "robotiq/telemetry.h"
+
+namespace robotiq {
+
+/**
+ * Records telemetry samples to a log.  Samples are pushed to a lock-free single producer,
+ * single consumer ring and a background thread appends them to the memory mapped file.
+ */
+class TelemetryRecorder {
+ public:
+  TelemetryRecorder();
+  TelemetryRecorder(const TelemetryRecorder&) = delete;
+  TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+  ~TelemetryRecorder();
+
+  /** Creates the log, truncating any existing file, and starts the flush thread */
+  bool open(const std::string& path);
+
+  /** Flushes the pending samples, stops the flush thread and closes the log */
+  void close();
+
+  /** Returns true if a log is open */
+  bool is_open() const { return m_fd >= 0; }
+
+  /** Queues a sample without blocking; the sample is dropped if the ring is full */
+  void record(const TelemetrySample& sample);
+
+  /** Returns the number of samples dropped because the ring was full */
+  uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+ private:
+  void run();
+  void drain();
+  bool append(const TelemetrySample& sample);
+  bool map_next_block(int64_t base_ns);
+  void unmap_block();
+
+  std::vector<TelemetrySample> m_ring;
+  std::atomic<std::size_t> m_head{0};
+  std::atomic<std::size_t> m_tail{0};
+  std::atomic<uint64_t> m_dropped{0};
+  std::atomic<bool> m_running{false};
+  std::thread m_thread;
+
+  int m_fd{-1};
+  std::size_t m_blocks{0};
+  uint8_t* m_block{nullptr};
+};
+
+}  // namespace robotiq
@@ -0,0 +1,164 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robotiq/transport.h"
+
+#include <thread>
+
+namespace robotiq {
+
+// Identifies a wire capture ("RGWC") and its format version
+static const char CAPTURE_MAGIC[4] = {'R', 'G', 'W', 'C'};
+static const uint32_t CAPTURE_VERSION = 1;
+
+CaptureTransport::CaptureTransport(std::unique_ptr<Transport> transport)
+    : m_transport(std::move(transport)) {}
+
+bool CaptureTransport::open(const std::string& path) {
+  m_file.open(path, std::ios::binary | std::ios::trunc);
+  if (not m_file) {
+    return false;
+  }
+  m_file.write(CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+  m_file.write(reinterpret_cast<const char*>(&CAPTURE_VERSION), sizeof(CAPTURE_VERSION));
+  m_start = std::chrono::steady_clock::now();
+  return static_cast<bool>(m_file);
+}
+
+bool CaptureTransport::write(const std::string& bytes) {
+  record(WIRE_WRITE, bytes);
+  return m_transport->write(bytes);
+}
+
+bool CaptureTransport::read_byte(char& c, std::size_t timeout_ms) {
+  if (not m_transport->read_byte(c, timeout_ms)) {
+    record(WIRE_READ_TIMEOUT, "");
+    return false;
+  }
+  record(WIRE_READ, std::string(1, c));
+  return true;
+}
+
+void CaptureTransport::flush_input() { m_transport->flush_input(); }
+
+void CaptureTransport::record(WireEventType type, const std::string& bytes) {
+  if (not m_file.is_open()) {
+    return;
+  }
+  int64_t offset_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - m_start)
+                          .count();
+  uint8_t event_type = type;
+  uint16_t length = static_cast<uint16_t>(bytes.size());
+  m_file.write(reinterpret_cast<const char*>(&offset_ns), sizeof(offset_ns));
+  m_file.write(reinterpret_cast<const char*>(&event_type), sizeof(event_type));
+  m_file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  m_file.write(bytes.data(), length);
+
+  // Keep the capture complete up to the last transaction in case of a crash
+  if (type != WIRE_READ) {
+    m_file.flush();
+  }
+}
+
+bool ReplayTransport::open(const std::string& path, double speedup) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[4];
+  uint32_t version = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (not file || not std::equal(magic, magic + 4, CAPTURE_MAGIC) ||
+      version != CAPTURE_VERSION) {
+    return false;
+  }
+
+  std::vector<WireEvent> events;
+  while (true) {
+    WireEvent event;
+    uint8_t event_type;
+    uint16_t length;
+    file.read(reinterpret_cast<char*>(&event.offset_ns), sizeof(event.offset_ns));
+    file.read(reinterpret_cast<char*>(&event_type), sizeof(event_type));
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+    if (not file || event_type > WIRE_READ_TIMEOUT) {
+      break;
+    }
+    event.type = static_cast<WireEventType>(event_type);
+    event.bytes.resize(length);
+    file.read(&event.bytes[0], length);
+    if (not file) {
+      break;
+    }
+    events.push_back(std::move(event));
+  }
+
+  load(events, speedup);
+  return true;
+}
+
+void ReplayTransport::load(const std::vector<WireEvent>& events, double speedup) {
+  m_events = events;
+  m_next = 0;
+  m_speedup = speedup;
+  m_mismatches = 0;
+}
+
+bool ReplayTransport::write(const std::string& bytes) {
+  // Skip responses the client did not read in the capture either
+  while (m_next < m_events.size() && m_events[m_next].type != WIRE_WRITE) {
+    ++m_next;
+  }
+  if (m_next >= m_events.size()) {
+    return false;
+  }
+
+  const WireEvent& event = m_events[m_next++];
+  if (event.bytes != bytes) {
+    ++m_mismatches;
+  }
+  m_write_offset_ns = event.offset_ns;
+  m_write_time = std::chrono::steady_clock::now();
+  return true;
+}
+
+bool ReplayTransport::read_byte(char& c, std::size_t timeout_ms) {
+  if (m_next >= m_events.size() || m_events[m_next].type == WIRE_WRITE) {
+    if (m_speedup > 0) {
+      std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(
+          static_cast<double>(timeout_ms) / m_speedup));
+    }
+    return false;
+  }
+
+  const WireEvent& event = m_events[m_next++];
+  wait_until(event.offset_ns);
+  if (event.type == WIRE_READ_TIMEOUT || event.bytes.empty()) {
+    return false;
+  }
+  c = event.bytes[0];
+  return true;
+}
+
+void ReplayTransport::flush_input() {}
+
+void ReplayTransport::wait_until(int64_t offset_ns) const {
+  if (m_speedup <= 0) {
+    return;
+  }
+  auto delay = std::chrono::nanoseconds(
+      static_cast<int64_t>((offset_ns - m_write_offset_ns) / m_speedup));
+  std::this_thread::sleep_until(m_write_time + delay);
+}
+
+}  // namespace robotiq
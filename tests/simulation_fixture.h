@@ -0,0 +1,45 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+namespace robotiq_tests {
+
+/**
+ * @brief Connects an interface to a simulated gripper behind the given impairments,
+ * which impair nothing by default, and activates it.  The activation is not checked,
+ * since impaired responses may fail it.
+ *
+ * @return The simulator, owned by the interface, to set objects and faults on.
+ */
+inline robotiq::SimulatedGripper* connect_simulated(
+    robotiq::RobotiqGripperInterface& gripper,
+    const robotiq::ImpairmentProfile& profile = {}) {
+  auto simulated = std::make_unique<robotiq::SimulatedGripper>();
+  robotiq::SimulatedGripper* raw = simulated.get();
+  EXPECT_TRUE(gripper.connect(
+      std::make_unique<robotiq::ImpairedTransport>(std::move(simulated), profile)));
+  gripper.set_timeout(20);
+  gripper.activate(false);
+  return raw;
+}
+
+}  // namespace robotiq_tests
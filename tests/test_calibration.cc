@@ -0,0 +1,94 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/calibration.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+namespace {
+
+/** Opening of a linkage whose fingers rotate through 90 degrees over the stroke */
+double opening(uint8_t word) { return 0.085 * std::cos(word / 255.0 * M_PI / 2); }
+
+}  // namespace
+
+TEST(calibration, build_and_invert) {
+  std::vector<robotiq::CalibrationPoint> points;
+  for (int word = 255; word >= 0; word -= 15) {
+    points.push_back({static_cast<uint8_t>(word), opening(static_cast<uint8_t>(word))});
+  }
+  robotiq::Calibration calibration;
+  ASSERT_TRUE(calibration.build(points));
+
+  for (const auto& point : points) {
+    EXPECT_NEAR(calibration.to_position(point.word), point.position, 1e-12);
+  }
+  for (int word = 0; word < 256; ++word) {
+    EXPECT_EQ(calibration.to_word(calibration.to_position(static_cast<uint8_t>(word))),
+              word);
+  }
+  EXPECT_EQ(calibration.to_word(1.0), 0);
+  EXPECT_EQ(calibration.to_word(-1.0), 255);
+
+  // The bisection finds the nearest word, also on the flat open end of the curve
+  for (double position = -0.001; position < 0.087; position += 1e-6) {
+    std::size_t nearest = 0;
+    for (std::size_t word = 1; word < 256; ++word) {
+      if (std::abs(calibration.to_position(word) - position) <
+          std::abs(calibration.to_position(nearest) - position)) {
+        nearest = word;
+      }
+    }
+    ASSERT_EQ(calibration.to_word(position), nearest) << position;
+  }
+
+  // Positions must be strictly monotonic
+  points.push_back({7, 0.0});
+  EXPECT_FALSE(robotiq::Calibration().build(points));
+  EXPECT_FALSE(robotiq::Calibration().build({{0, 0.0}}));
+}
+
+TEST(calibration, sweep_save_and_load) {
+  std::string path = testing::TempDir() + "robotiq_calibration_test.bin";
+  std::remove(path.c_str());
+
+  {
+    robotiq::RobotiqGripperInterface gripper;
+    gripper.set_calibration_path(path);
+    robotiq::SimulatedGripperConfig config;
+    config.full_stroke_time_s = 0.01;
+    ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>(config)));
+    gripper.set_timeout(20);
+    gripper.activate(false);
+    ASSERT_TRUE(gripper.calibrate(opening, 18));
+    EXPECT_NEAR(gripper.get_feedback()->position, opening(255), 1e-12);
+  }
+
+  // A new connection loads the saved calibration
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.set_calibration_path(path);
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>()));
+  gripper.set_timeout(20);
+  gripper.activate(false);
+  ASSERT_TRUE(gripper.set_gripper_position(opening(120)));
+  robotiq::GripperFeedback y = gripper.get_feedback().value();
+  EXPECT_EQ(y.raw_commanded_position, 120);
+  EXPECT_NEAR(y.position, opening(120), 1e-4);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,96 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/discovery.h"
+#include "robotiq/simulation.h"
+
+namespace {
+
+/** Gripper without the settle time after activation, which the test does not need */
+class NoSettleGripper : public robotiq::RobotiqGripperInterface {
+ public:
+  NoSettleGripper() {
+    robotiq::ModelParameters parameters;
+    parameters.activation_settle_ms = 0;
+    set_model_parameters(parameters);
+  }
+};
+
+}  // namespace
+
+TEST(discovery, probes_and_activates_in_parallel) {
+  // Simulated ports, by the slave id of their gripper
+  std::map<std::string, uint8_t> slave_ids = {
+      {"sim9", 9}, {"sim10", 10}, {"sim11", 11}, {"sim20", 20}};
+  const std::vector<std::string> ports = {"sim9", "sim10", "sim11", "sim20", "missing"};
+
+  // Every port waits at opening until all of them are open, which only completes if
+  // the ports are handled at the same time.  The timeout only bounds a failing test.
+  std::mutex mutex;
+  std::condition_variable opened;
+  std::size_t opening = 0;
+  bool concurrent = true;
+
+  robotiq::DiscoveryOptions options;
+  options.slave_ids = {9, 10, 11};
+  options.open_transport = [&](const std::string& port) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ++opening;
+      opened.notify_all();
+      if (not opened.wait_for(lock, std::chrono::seconds(10),
+                              [&] { return opening == ports.size(); })) {
+        concurrent = false;
+      }
+    }
+    std::unique_ptr<robotiq::Transport> transport;
+    if (slave_ids.count(port) > 0) {
+      robotiq::SimulatedGripperConfig config;
+      config.slave_id = slave_ids.at(port);
+      config.activation_time_ms = 300;
+      transport = std::make_unique<robotiq::SimulatedGripper>(config);
+    }
+    return transport;
+  };
+  options.connect_gripper = [](std::unique_ptr<robotiq::Transport> transport) {
+    std::unique_ptr<robotiq::RobotiqGripperInterface> gripper =
+        std::make_unique<NoSettleGripper>();
+    gripper->connect(std::move(transport));
+    return gripper;
+  };
+
+  std::vector<robotiq::DiscoveredGripper> grippers =
+      robotiq::discover_grippers(ports, options);
+  EXPECT_TRUE(concurrent);
+
+  ASSERT_EQ(grippers.size(), 5u);
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(grippers[i].error, robotiq::ErrorCode::NONE);
+    EXPECT_EQ(grippers[i].slave_id, slave_ids.at(grippers[i].port));
+    EXPECT_EQ(grippers[i].status.gact, robotiq::ActivationStatus::NOT_ACTIVATED);
+    EXPECT_TRUE(grippers[i].activated);
+    ASSERT_NE(grippers[i].gripper, nullptr);
+    EXPECT_TRUE(grippers[i].gripper->is_activated().value());
+  }
+  EXPECT_EQ(grippers[3].error, robotiq::ErrorCode::TIMEOUT);
+  EXPECT_EQ(grippers[3].gripper, nullptr);
+  EXPECT_EQ(grippers[4].error, robotiq::ErrorCode::PORT_ERROR);
+}
@@ -0,0 +1,174 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/feedback_ring.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+using robotiq::FEEDBACK_RING_CAPACITY;
+using robotiq::FeedbackRing;
+using robotiq::FeedbackSpans;
+
+namespace {
+
+FeedbackRing::Clock::time_point at_ms(int64_t ms) {
+  return FeedbackRing::Clock::time_point(std::chrono::milliseconds(ms));
+}
+
+robotiq::GripperFeedback sample(int64_t ms, uint8_t position, uint8_t commanded,
+                                bool in_motion) {
+  robotiq::GripperFeedback feedback;
+  feedback.raw_position = position;
+  feedback.raw_commanded_position = commanded;
+  feedback.status.gobj = in_motion ? robotiq::ObjectStatus::IN_MOTION
+                                   : robotiq::ObjectStatus::AT_REQUESTED_POSITION;
+  feedback.timing.sampled = at_ms(ms);
+  return feedback;
+}
+
+robotiq::GripperFeedback sample(int64_t ms) {
+  robotiq::GripperFeedback feedback;
+  feedback.raw_position = static_cast<uint8_t>(ms);
+  feedback.raw_commanded_position = 255;
+  feedback.current = 0.5;
+  feedback.status.gact = robotiq::ActivationStatus::ACTIVATED;
+  feedback.status.ggto = robotiq::ActionStatus::GOTO_POSITION;
+  feedback.status.gsta = robotiq::FingerStatus::ACTIVATION_COMPLETE;
+  feedback.status.gobj = robotiq::ObjectStatus::IN_MOTION;
+  feedback.timing.sampled = at_ms(ms);
+  return feedback;
+}
+
+}  // namespace
+
+TEST(feedback_ring, returns_contiguous_spans_across_wraparound) {
+  FeedbackRing ring;
+  EXPECT_EQ(ring.last(10).size, 0u);
+
+  const int64_t pushed = FEEDBACK_RING_CAPACITY + 100;
+  for (int64_t ms = 0; ms < pushed; ++ms) {
+    ring.push(sample(ms));
+  }
+  EXPECT_EQ(ring.size(), FEEDBACK_RING_CAPACITY);
+
+  // Every window is contiguous and in time order, even across the end of the ring
+  FeedbackSpans all = ring.last(1000);
+  ASSERT_EQ(all.size, FEEDBACK_RING_CAPACITY);
+  for (std::size_t i = 0; i < all.size; ++i) {
+    int64_t ms = pushed - static_cast<int64_t>(FEEDBACK_RING_CAPACITY - i);
+    EXPECT_EQ(all.stamp_ns[i], ms * 1000000);
+    EXPECT_EQ(all.raw_position[i], static_cast<uint8_t>(ms));
+  }
+  FeedbackSpans recent = ring.last(3);
+  ASSERT_EQ(recent.size, 3u);
+  EXPECT_EQ(recent.raw_position[2], static_cast<uint8_t>(pushed - 1));
+  EXPECT_EQ(recent.raw_commanded_position[0], 255);
+  EXPECT_EQ(recent.raw_current[0], 128);
+  EXPECT_EQ(recent.status[0], 0x29);
+
+  FeedbackSpans window = ring.window(at_ms(200), at_ms(300));
+  ASSERT_EQ(window.size, 101u);
+  EXPECT_EQ(window.stamp_ns[0], 200 * 1000000);
+  EXPECT_EQ(window.stamp_ns[100], 300 * 1000000);
+  EXPECT_EQ(ring.window(at_ms(0), at_ms(50)).size, 0u);
+
+  robotiq::DetailedStatus status = FeedbackRing::unpack_status(recent.status[0]);
+  EXPECT_EQ(status.gobj, robotiq::ObjectStatus::IN_MOTION);
+  EXPECT_EQ(status.gsta, robotiq::FingerStatus::ACTIVATION_COMPLETE);
+  EXPECT_EQ(status.ggto, robotiq::ActionStatus::GOTO_POSITION);
+  EXPECT_EQ(status.gact, robotiq::ActivationStatus::ACTIVATED);
+}
+
+TEST(feedback_ring, interpolates_and_extrapolates) {
+  FeedbackRing ring;
+  double word = 0;
+  EXPECT_FALSE(ring.word_at(at_ms(0), word));
+
+  ring.push(sample(0, 10, 50, true));
+  ring.push(sample(10, 20, 50, true));
+  ring.push(sample(20, 30, 50, true));
+  ASSERT_TRUE(ring.word_at(at_ms(15), word));
+  EXPECT_NEAR(word, 25, 1e-9);
+  ASSERT_TRUE(ring.word_at(at_ms(-5), word));
+  EXPECT_NEAR(word, 10, 1e-9);
+
+  // Moving fingers are extrapolated up to the commanded position
+  ASSERT_TRUE(ring.word_at(at_ms(25), word));
+  EXPECT_NEAR(word, 35, 1e-9);
+  ASSERT_TRUE(ring.word_at(at_ms(100), word));
+  EXPECT_NEAR(word, 50, 1e-9);
+
+  // Stopped fingers stay put
+  ring.push(sample(30, 32, 50, false));
+  ASSERT_TRUE(ring.word_at(at_ms(100), word));
+  EXPECT_NEAR(word, 32, 1e-9);
+}
+
+TEST(feedback_ring, stamps_feedback) {
+  robotiq::SimulatedGripperConfig config;
+  config.turnaround_us = 2000;
+  robotiq::RobotiqGripperInterface gripper;
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>(config)));
+  gripper.set_timeout(20);
+  ASSERT_TRUE(gripper.activate(false));
+
+  // The estimate lies in the turnaround, after the 8 request bytes and before the first
+  // response byte, at 87 us per byte.  Only lower bounds hold on a loaded host.
+  robotiq::GripperFeedback y = gripper.get_feedback().value();
+  const robotiq::FeedbackTiming& t = y.timing;
+  EXPECT_LT(t.sent, t.sampled);
+  EXPECT_LT(t.sampled, t.first_byte);
+  EXPECT_LT(t.first_byte, t.completed);
+  EXPECT_GE(t.first_byte - t.sent, std::chrono::microseconds(2000 + 9 * 86));
+  EXPECT_GE(t.sampled - t.sent, std::chrono::microseconds(8 * 86 + 1000));
+
+  // Positions between two polls of a move are between their positions
+  ASSERT_TRUE(gripper.set_gripper_position(1, false));
+  robotiq::GripperFeedback before = gripper.get_feedback().value();
+  robotiq::GripperFeedback after = gripper.get_feedback().value();
+  ASSERT_LT(before.position, after.position);
+  double position = 0;
+  auto interval = after.timing.sampled - before.timing.sampled;
+  auto middle = before.timing.sampled + interval / 2;
+  ASSERT_TRUE(gripper.position_at(middle, position));
+  EXPECT_GT(position, before.position);
+  EXPECT_LT(position, after.position);
+}
+
+TEST(feedback_ring, records_interface_feedback) {
+  robotiq::RobotiqGripperInterface gripper;
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>()));
+  gripper.set_timeout(20);
+  ASSERT_TRUE(gripper.activate(false));
+  ASSERT_TRUE(gripper.set_gripper_position(1, false));
+  robotiq::GripperFeedback before = gripper.get_feedback().value();
+  robotiq::GripperFeedback after = gripper.get_feedback().value();
+
+  FeedbackSpans last = gripper.get_feedback_history(2);
+  ASSERT_EQ(last.size, 2u);
+  EXPECT_EQ(last.raw_position[0], before.raw_position);
+  EXPECT_EQ(last.raw_position[1], after.raw_position);
+  EXPECT_EQ(last.status[1], FeedbackRing::pack_status(after.status));
+
+  FeedbackSpans window =
+      gripper.get_feedback_history(before.timing.sampled, after.timing.sampled);
+  ASSERT_EQ(window.size, 2u);
+  EXPECT_EQ(window.stamp_ns, last.stamp_ns);
+
+  // A new connection starts a new history
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>()));
+  EXPECT_EQ(gripper.get_feedback_history(10).size, 0u);
+}
@@ -0,0 +1,136 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/grasp_monitor.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+namespace {
+
+/** Creates a feedback sample with a command of 255 (closed) */
+robotiq::GripperFeedback sample(robotiq::ObjectStatus gobj, uint8_t position,
+                                double current) {
+  robotiq::GripperFeedback y;
+  y.status.gobj = gobj;
+  y.raw_commanded_position = 255;
+  y.raw_position = position;
+  y.current = current;
+  return y;
+}
+
+}  // namespace
+
+TEST(grasp_monitor, moving_statistics) {
+  robotiq::MovingStatistics statistics(4);
+  for (double value : {10.0, 1.0, 2.0, 3.0, 4.0}) {
+    statistics.push(value);
+  }
+  EXPECT_TRUE(statistics.full());
+  EXPECT_DOUBLE_EQ(statistics.mean(), 2.5);
+  EXPECT_NEAR(statistics.stddev(), std::sqrt(1.25), 1e-12);
+  statistics.clear();
+  EXPECT_EQ(statistics.size(), 0u);
+  EXPECT_EQ(statistics.stddev(), 0);
+}
+
+TEST(grasp_monitor, contact_from_current_and_lost_from_current) {
+  using robotiq::ObjectStatus;
+  robotiq::GraspMonitor monitor;
+  for (uint8_t position = 0; position < 100; position += 4) {
+    double current = position % 8 == 0 ? 0.04 : 0.05;
+    EXPECT_EQ(monitor.update(sample(ObjectStatus::IN_MOTION, position, current)),
+              robotiq::GraspEvent::NONE);
+  }
+
+  // The current rises before the gripper reports that it stopped
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::IN_MOTION, 101, 0.4)),
+            robotiq::GraspEvent::CONTACT);
+  EXPECT_TRUE(monitor.in_contact());
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::STOPPED_WHILE_CLOSING, 101, 0.5)),
+            robotiq::GraspEvent::NONE);
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::STOPPED_WHILE_CLOSING, 101, 0.05)),
+            robotiq::GraspEvent::OBJECT_LOST);
+  EXPECT_FALSE(monitor.in_contact());
+
+  // A new command releases the object without an event
+  monitor.update(sample(ObjectStatus::STOPPED_WHILE_CLOSING, 101, 0.5));
+  robotiq::GripperFeedback release = sample(ObjectStatus::IN_MOTION, 100, 0.04);
+  release.raw_commanded_position = 0;
+  EXPECT_EQ(monitor.update(release), robotiq::GraspEvent::NONE);
+  EXPECT_FALSE(monitor.in_contact());
+}
+
+TEST(grasp_monitor, squeeze_after_contact_is_not_a_slip) {
+  using robotiq::ObjectStatus;
+  robotiq::GraspMonitor monitor;
+  for (uint8_t position = 0; position < 100; position += 4) {
+    monitor.update(sample(ObjectStatus::IN_MOTION, position, 0.05));
+  }
+
+  // The fingers keep closing on the object after the current rose
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::IN_MOTION, 101, 0.4)),
+            robotiq::GraspEvent::CONTACT);
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::IN_MOTION, 103, 0.5)),
+            robotiq::GraspEvent::NONE);
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::STOPPED_WHILE_CLOSING, 105, 0.5)),
+            robotiq::GraspEvent::NONE);
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::STOPPED_WHILE_CLOSING, 105, 0.5)),
+            robotiq::GraspEvent::NONE);
+
+  // Closing past the stop position is a slip
+  EXPECT_EQ(monitor.update(sample(ObjectStatus::IN_MOTION, 108, 0.3)),
+            robotiq::GraspEvent::SLIP);
+  EXPECT_TRUE(monitor.in_contact());
+}
+
+TEST(grasp_monitor, slip_and_lost_on_simulated_gripper) {
+  auto simulated = std::make_unique<robotiq::SimulatedGripper>();
+  robotiq::SimulatedGripper* raw = simulated.get();
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.connect(std::move(simulated));
+  gripper.activate(false);
+
+  robotiq::GraspMonitor monitor;
+  std::vector<robotiq::GraspEvent> events;
+  gripper.set_feedback_callback([&](const robotiq::GripperFeedback& y) {
+    robotiq::GraspEvent event = monitor.update(y);
+    if (event != robotiq::GraspEvent::NONE) {
+      events.push_back(event);
+    }
+  });
+
+  raw->set_object(150);
+  EXPECT_TRUE(gripper.close_gripper());
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0], robotiq::GraspEvent::CONTACT);
+
+  // Follow the fingers until they stop on the slipped object, then on nothing
+  raw->set_object(200);
+  while (gripper.get_feedback()->status.gobj == robotiq::ObjectStatus::IN_MOTION) {
+  }
+  EXPECT_TRUE(monitor.in_contact());
+  EXPECT_GE(std::count(events.begin(), events.end(), robotiq::GraspEvent::SLIP), 1);
+
+  raw->set_object(-1);
+  while (gripper.get_feedback()->status.gobj == robotiq::ObjectStatus::IN_MOTION) {
+  }
+  EXPECT_FALSE(monitor.in_contact());
+  EXPECT_EQ(events.back(), robotiq::GraspEvent::OBJECT_LOST);
+}
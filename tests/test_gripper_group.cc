@@ -0,0 +1,76 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/gripper_group.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+#include "tests/simulation_fixture.h"
+
+using robotiq::GripperTarget;
+
+TEST(gripper_group, batched_command_and_wait_for_all) {
+  robotiq::RobotiqGripperInterface grippers[2];
+  for (auto& gripper : grippers) {
+    robotiq_tests::connect_simulated(gripper);
+  }
+  robotiq::GripperGroup group({&grippers[0], &grippers[1]});
+  EXPECT_EQ(group.size(), 2u);
+  EXPECT_EQ(group.set_gripper_positions({GripperTarget{}}).error(),
+            robotiq::ErrorCode::INVALID_ARGUMENT);
+
+  // Both commands are acknowledged before the motion is awaited
+  ASSERT_TRUE(group.set_gripper_positions({{0.2, 1, 1}, {0.4, 1, 1}}));
+  EXPECT_EQ(grippers[0].get_feedback()->raw_commanded_position, 51);
+  EXPECT_EQ(grippers[1].get_feedback()->raw_commanded_position, 102);
+
+  ASSERT_TRUE(group.wait_for_all(std::chrono::seconds(2)));
+  EXPECT_EQ(grippers[0].get_feedback()->raw_position, 51);
+  EXPECT_EQ(grippers[1].get_feedback()->raw_position, 102);
+
+  // A move longer than the timeout does not complete
+  ASSERT_TRUE(group.set_gripper_positions({{1, 0, 1}, {0, 0, 1}}));
+  EXPECT_EQ(group.wait_for_all(std::chrono::milliseconds(20)).error(),
+            robotiq::ErrorCode::MOTION_TIMEOUT);
+}
+
+TEST(gripper_group, wait_for_any_returns_first_finished) {
+  robotiq::RobotiqGripperInterface grippers[2];
+  for (auto& gripper : grippers) {
+    robotiq_tests::connect_simulated(gripper);
+  }
+  robotiq::GripperGroup group({&grippers[0], &grippers[1]});
+
+  // The second gripper has the shorter move
+  ASSERT_TRUE(group.set_gripper_positions({{1, 0, 1}, {0.1, 1, 1}}));
+  EXPECT_EQ(group.wait_for_any(std::chrono::seconds(2)).value(), 1);
+  EXPECT_EQ(grippers[0].get_feedback()->status.gobj, robotiq::ObjectStatus::IN_MOTION);
+
+  // Neither slow move finishes within the timeout
+  ASSERT_TRUE(group.set_gripper_positions({{0, 0, 1}, {1, 0, 1}}));
+  EXPECT_EQ(group.wait_for_any(std::chrono::milliseconds(20)).error(),
+            robotiq::ErrorCode::MOTION_TIMEOUT);
+}
+
+TEST(gripper_group, wait_for_any_reports_failed_reads) {
+  robotiq::RobotiqGripperInterface grippers[2];
+  robotiq_tests::connect_simulated(grippers[0]);
+  robotiq::GripperGroup group({&grippers[0], &grippers[1]});
+
+  // The unconnected gripper fails instead of looking like a timeout
+  ASSERT_TRUE(grippers[0].set_gripper_position(1, 0, 1, false));
+  EXPECT_EQ(group.wait_for_any(std::chrono::seconds(2)).error(),
+            robotiq::ErrorCode::NOT_CONNECTED);
+}
@@ -0,0 +1,50 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/gripper_models.h"
+#include "robotiq/simulation.h"
+
+using Scaling2F85 = robotiq::ModelScaling<robotiq::Robotiq2F85>;
+using Scaling2F140 = robotiq::ModelScaling<robotiq::Robotiq2F140>;
+using ScalingHandE = robotiq::ModelScaling<robotiq::RobotiqHandE>;
+
+// The conversions are evaluated at compile time
+static_assert(Scaling2F85::width_to_word(0.085) == 0, "Open at the full stroke");
+static_assert(Scaling2F85::width_to_word(0) == 255, "Closed at zero width");
+static_assert(Scaling2F140::width_to_word(0.2) == 0, "Clamped above the stroke");
+static_assert(ScalingHandE::width_to_word(-0.01) == 255, "Clamped below zero");
+static_assert(Scaling2F85::speed_to_word(0.150) == 255, "Maximum speed");
+static_assert(Scaling2F140::force_to_word(5) == 0, "Clamped below the minimum force");
+
+TEST(gripper_models, scaling) {
+  EXPECT_EQ(Scaling2F85::width_to_word(0.0425), 128);
+  EXPECT_NEAR(Scaling2F85::word_to_width(128), 0.0425, 0.085 / 255);
+  EXPECT_NEAR(ScalingHandE::word_to_width(0), 0.05, 1e-12);
+  EXPECT_EQ(Scaling2F140::speed_to_word(0.140), 128);
+  EXPECT_EQ(ScalingHandE::force_to_word(102.5), 128);
+}
+
+TEST(gripper_models, set_width) {
+  robotiq::RobotiqGripper<robotiq::RobotiqHandE> gripper;
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>()));
+  gripper.set_timeout(20);
+  gripper.activate(false);
+
+  EXPECT_TRUE(gripper.set_width(0.025));
+  robotiq::GripperFeedback y = gripper.get_feedback().value();
+  EXPECT_EQ(y.raw_commanded_position, ScalingHandE::width_to_word(0.025));
+  EXPECT_NEAR(y.position, 0.025, 0.05 / 255);
+}
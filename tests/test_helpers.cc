@@ -21,7 +21,20 @@ TEST(helpers, uint8_to_hex) {
   EXPECT_EQ(robotiq::uint8_to_hex(255), "FF");
 }
 
+TEST(helpers, uint16_to_hex) {
+  EXPECT_EQ(robotiq::uint16_to_hex(0x07D0), "07D0");
+  EXPECT_EQ(robotiq::hex_to_uint16("07D0"), 0x07D0);
+  EXPECT_EQ(robotiq::hex_to_uint16("FFFF"), 0xFFFF);
+}
+
 TEST(helpers, crc_checks) {
   EXPECT_EQ(robotiq::crc16_modbus("091003E8000306090000FFFFFF"), "4229");
   EXPECT_EQ(robotiq::crc16_modbus("091003E800030609000000FFFF"), "7219");
 }
+
+TEST(helpers, has_valid_crc) {
+  EXPECT_TRUE(robotiq::has_valid_crc("090307D00003040E"));
+  EXPECT_TRUE(robotiq::has_valid_crc("091003E800030130"));
+  EXPECT_FALSE(robotiq::has_valid_crc("090307D00003040F"));
+  EXPECT_FALSE(robotiq::has_valid_crc("0903"));
+}
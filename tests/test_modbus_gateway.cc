@@ -0,0 +1,85 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "tools/modbus_gateway/transaction_queue.h"
+
+namespace {
+
+/** Returns a read of count holding registers from address */
+Pdu read(uint16_t address, uint16_t count) {
+  return {FC_READ_HOLDING_REGISTERS, static_cast<uint8_t>(address >> 8),
+          static_cast<uint8_t>(address & 0xFF), static_cast<uint8_t>(count >> 8),
+          static_cast<uint8_t>(count & 0xFF)};
+}
+
+/** Returns a write of one holding register */
+Pdu write(uint16_t address, uint16_t value) {
+  return {FC_WRITE_SINGLE_REGISTER, static_cast<uint8_t>(address >> 8),
+          static_cast<uint8_t>(address & 0xFF), static_cast<uint8_t>(value >> 8),
+          static_cast<uint8_t>(value & 0xFF)};
+}
+
+/** A completion that counts its calls */
+Completion count(int& calls) {
+  return [&calls](const Pdu&) { ++calls; };
+}
+
+}  // namespace
+
+TEST(modbus_gateway, coalesces_identical_queued_reads) {
+  TransactionQueue queue;
+  int calls = 0;
+  EXPECT_TRUE(queue.push(read(0x07D0, 3), count(calls)));
+  EXPECT_FALSE(queue.push(read(0x07D0, 3), count(calls)));
+  EXPECT_TRUE(queue.push(read(0x07D0, 1), count(calls)));
+
+  std::shared_ptr<Job> job = queue.pop();
+  EXPECT_EQ(job->request, read(0x07D0, 3));
+  ASSERT_EQ(job->waiters.size(), 2u);
+  for (auto& waiter : job->waiters) {
+    waiter(Pdu{});
+  }
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(queue.pop()->waiters.size(), 1u);
+  EXPECT_TRUE(queue.empty());
+
+  // A read arriving after its transaction left the queue gets a fresh one
+  EXPECT_TRUE(queue.push(read(0x07D0, 3), count(calls)));
+}
+
+TEST(modbus_gateway, write_ends_coalescing_of_earlier_reads) {
+  TransactionQueue queue;
+  int calls = 0;
+  ASSERT_TRUE(queue.push(read(0x07D0, 3), count(calls)));
+  ASSERT_TRUE(queue.push(write(0x03E8, 0x0900), count(calls)));
+
+  // The read after the write must see the written value
+  EXPECT_TRUE(queue.push(read(0x07D0, 3), count(calls)));
+  EXPECT_FALSE(queue.push(read(0x07D0, 3), count(calls)));
+
+  // Transactions leave in arrival order
+  std::shared_ptr<Job> first = queue.pop();
+  EXPECT_EQ(first->request, read(0x07D0, 3));
+  EXPECT_EQ(first->waiters.size(), 1u);
+  EXPECT_EQ(queue.pop()->request, write(0x03E8, 0x0900));
+
+  // Popping the earlier read keeps the later one open for coalescing
+  EXPECT_FALSE(queue.push(read(0x07D0, 3), count(calls)));
+  std::shared_ptr<Job> last = queue.pop();
+  EXPECT_EQ(last->request, read(0x07D0, 3));
+  EXPECT_EQ(last->waiters.size(), 3u);
+  EXPECT_TRUE(queue.empty());
+}
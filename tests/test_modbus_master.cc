@@ -0,0 +1,116 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+#include "src/helpers.h"
+#include "tests/simulation_fixture.h"
+
+using robotiq::ErrorCode;
+using robotiq::RegisterRead;
+using robotiq::RegisterTable;
+using robotiq::RegisterWrite;
+
+TEST(modbus_master, merges_adjacent_and_overlapping_reads) {
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq_tests::connect_simulated(gripper);
+  ASSERT_TRUE(gripper.set_gripper_position(0.5, 1, 0.5, false));
+
+  RegisterRead status{RegisterTable::HOLDING, 0x07D0, 1};
+  RegisterRead positions{RegisterTable::HOLDING, 0x07D1, 2};
+  RegisterRead inputs{RegisterTable::HOLDING, 0x07D0, 3};
+  RegisterRead outputs{RegisterTable::HOLDING, 0x03E8, 3};
+  RegisterRead force{RegisterTable::HOLDING, 0x03EA, 1};
+  RegisterRead input_table{RegisterTable::INPUT, 0x07D0, 1};
+  for (RegisterRead* read :
+       {&status, &positions, &inputs, &outputs, &force, &input_table}) {
+    gripper.queue_request(*read);
+  }
+  robotiq::RegisterCacheStats before = gripper.get_cache_stats();
+  ASSERT_TRUE(gripper.execute_requests());
+  robotiq::RegisterCacheStats after = gripper.get_cache_stats();
+
+  // One read per table and contiguous span
+  EXPECT_EQ(after.transactions, before.transactions + 3);
+  EXPECT_EQ(after.merged_reads, before.merged_reads + 3);
+  ASSERT_EQ(inputs.values.size(), 3u);
+  EXPECT_EQ(status.values, std::vector<uint16_t>{inputs.values[0]});
+  EXPECT_EQ(positions.values,
+            std::vector<uint16_t>(inputs.values.begin() + 1, inputs.values.end()));
+  EXPECT_EQ(outputs.values, (std::vector<uint16_t>{0x0900, 127, 0xFF80}));
+  EXPECT_EQ(force.values, std::vector<uint16_t>{0xFF80});
+  EXPECT_EQ(input_table.error, ErrorCode::NONE);
+  EXPECT_EQ(input_table.values.size(), 1u);
+}
+
+TEST(modbus_master, keeps_order_around_writes) {
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq_tests::connect_simulated(gripper);
+
+  RegisterRead old_outputs{RegisterTable::HOLDING, 0x03E8, 3};
+  RegisterWrite command{0x03E8, {0x0900, 200, 0xFFFF}};
+  RegisterRead new_outputs{RegisterTable::HOLDING, 0x03E8, 3};
+  gripper.queue_request(old_outputs);
+  gripper.queue_request(command);
+  gripper.queue_request(new_outputs);
+  ASSERT_TRUE(gripper.execute_requests());
+  EXPECT_EQ(old_outputs.values, (std::vector<uint16_t>{0x0100, 0, 0}));
+  EXPECT_EQ(command.error, ErrorCode::NONE);
+  EXPECT_EQ(new_outputs.values, command.values);
+  EXPECT_EQ(gripper.get_feedback()->raw_commanded_position, 200);
+}
+
+TEST(modbus_master, reports_errors_per_request) {
+  robotiq::RobotiqGripperInterface gripper;
+  RegisterRead status{RegisterTable::HOLDING, 0x07D0, 1};
+  gripper.queue_request(status);
+  EXPECT_EQ(gripper.execute_requests().error(), ErrorCode::NOT_CONNECTED);
+  EXPECT_EQ(status.error, ErrorCode::NOT_CONNECTED);
+
+  robotiq_tests::connect_simulated(gripper);
+  RegisterRead empty{RegisterTable::HOLDING, 0x07D0, 0};
+  RegisterRead unknown{RegisterTable::HOLDING, 0x0100, 2};
+  RegisterRead unknown_next{RegisterTable::HOLDING, 0x0101, 2};
+  for (RegisterRead* read : {&status, &empty, &unknown, &unknown_next}) {
+    gripper.queue_request(*read);
+  }
+  EXPECT_FALSE(gripper.execute_requests());
+  EXPECT_EQ(status.error, ErrorCode::NONE);
+  EXPECT_EQ(empty.error, ErrorCode::INVALID_ARGUMENT);
+  EXPECT_EQ(unknown.error, ErrorCode::MODBUS_EXCEPTION);
+  EXPECT_EQ(unknown_next.error, ErrorCode::MODBUS_EXCEPTION);
+}
+
+TEST(modbus_master, impairs_input_register_reads) {
+  robotiq::ImpairmentProfile profile;
+  profile.fault_probability = 1;
+  profile.fault = robotiq::FaultStatus::OVERCURRENT;
+  auto impaired = std::make_unique<robotiq::ImpairedTransport>(
+      std::make_unique<robotiq::SimulatedGripper>(), profile);
+  robotiq::ImpairedTransport* transport = impaired.get();
+  robotiq::RobotiqGripperInterface gripper;
+  ASSERT_TRUE(gripper.connect(std::move(impaired)));
+  gripper.set_timeout(20);
+
+  // The whole FC04 response is framed, so the fault lands in its status with a valid CRC
+  RegisterRead status{RegisterTable::INPUT, 0x07D0, 3};
+  gripper.queue_request(status);
+  ASSERT_TRUE(gripper.execute_requests());
+  ASSERT_EQ(status.values.size(), 3u);
+  uint8_t fault = static_cast<uint8_t>((status.values[1] >> 8) & 0x0F);
+  EXPECT_EQ(robotiq::code_to_fault(fault), robotiq::FaultStatus::OVERCURRENT);
+  EXPECT_EQ(transport->counters().faults, 1u);
+}
@@ -0,0 +1,36 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "src/motion_model.h"
+
+using robotiq::MotionModel;
+
+TEST(motion_model, learns_rate) {
+  MotionModel model;
+  MotionModel::Clock::time_point t0;
+  for (int i = 0; i < 50; ++i) {
+    model.update(static_cast<uint8_t>(2 * i), true,
+                 t0 + std::chrono::milliseconds(10 * i));
+  }
+  EXPECT_NEAR(model.rate(), 200.0, 1.0);
+  EXPECT_NEAR(model.time_to_target(0, 200), 1.0, 0.01);
+}
+
+TEST(motion_model, poll_delay_shrinks_near_target) {
+  MotionModel model;
+  EXPECT_GT(model.poll_delay(0, 255), model.poll_delay(200, 255));
+  EXPECT_EQ(model.poll_delay(254, 255).count(), 0);
+}
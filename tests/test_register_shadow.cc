@@ -0,0 +1,133 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+#include "src/register_shadow.h"
+
+using robotiq::INPUT_REGISTERS_ADDRESS;
+using robotiq::OUTPUT_REGISTERS_ADDRESS;
+using robotiq::RegisterShadow;
+
+TEST(register_shadow, confirms_by_acknowledgement_or_echo) {
+  RegisterShadow shadow;
+  RegisterShadow::Clock::time_point t0;
+  auto freshness = std::chrono::milliseconds(50);
+  const RegisterShadow::Registers outputs{0x0900, 0x0080, 0xFFFF};
+  const RegisterShadow::Registers executing{0x0900, 0x0080, 0x8000};
+  const RegisterShadow::Registers faulted{0x0900, 0x0580, 0x8000};
+
+  // Unconfirmed until the feedback echoes the position
+  shadow.sent(OUTPUT_REGISTERS_ADDRESS, outputs.data(), outputs.size());
+  EXPECT_FALSE(shadow.is_redundant(outputs, t0, freshness));
+  shadow.received(INPUT_REGISTERS_ADDRESS, executing.data(), executing.size(), t0);
+  EXPECT_TRUE(shadow.is_redundant(outputs, t0, freshness));
+  EXPECT_FALSE(shadow.is_redundant({0x0900, 0x0081, 0xFFFF}, t0, freshness));
+
+  // Stale or faulted inputs, or no freshness window, do not confirm the state
+  EXPECT_FALSE(shadow.is_redundant(outputs, t0 + 2 * freshness, freshness));
+  EXPECT_FALSE(shadow.is_redundant(outputs, t0, RegisterShadow::Clock::duration::zero()));
+  shadow.received(INPUT_REGISTERS_ADDRESS, faulted.data(), faulted.size(), t0);
+  EXPECT_FALSE(shadow.is_redundant(outputs, t0, freshness));
+
+  // An acknowledged write is confirmed, a failed one forgets the outputs
+  shadow.received(INPUT_REGISTERS_ADDRESS, executing.data(), executing.size(), t0);
+  shadow.sent(OUTPUT_REGISTERS_ADDRESS, outputs.data(), outputs.size());
+  shadow.acknowledged();
+  EXPECT_TRUE(shadow.is_redundant(outputs, t0, freshness));
+  shadow.invalidate_outputs();
+  EXPECT_FALSE(shadow.is_redundant(outputs, t0, freshness));
+
+  // A partial write leaves the other registers unconfirmed
+  shadow.sent(OUTPUT_REGISTERS_ADDRESS + 1, outputs.data() + 1, 2);
+  shadow.acknowledged();
+  EXPECT_FALSE(shadow.is_redundant(outputs, t0, freshness));
+
+  // A write of new action bits makes the status unknown, a new position does not
+  RegisterShadow::Registers inputs;
+  shadow.sent(OUTPUT_REGISTERS_ADDRESS, outputs.data(), outputs.size());
+  shadow.received(INPUT_REGISTERS_ADDRESS, executing.data(), executing.size(), t0);
+  const RegisterShadow::Registers moved{0x0900, 0x0090, 0xFFFF};
+  shadow.sent(OUTPUT_REGISTERS_ADDRESS, moved.data(), moved.size());
+  EXPECT_TRUE(shadow.fresh_inputs(t0, freshness, inputs));
+  const RegisterShadow::Registers reset{};
+  shadow.sent(OUTPUT_REGISTERS_ADDRESS, reset.data(), reset.size());
+  shadow.acknowledged();
+  EXPECT_FALSE(shadow.fresh_inputs(t0, freshness, inputs));
+}
+
+TEST(register_shadow, reset_forgets_cached_status) {
+  robotiq::RobotiqGripperInterface gripper;
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>()));
+  gripper.set_timeout(20);
+  gripper.set_cache_freshness(1000);
+  ASSERT_TRUE(gripper.activate(false));
+  while (not gripper.is_activated().value()) {
+  }
+  ASSERT_TRUE(gripper.get_feedback());
+  EXPECT_TRUE(gripper.is_activated().value());
+
+  // The status after the reset is read from the gripper, not from the shadow
+  ASSERT_TRUE(gripper.reset(false));
+  robotiq::RegisterCacheStats before = gripper.get_cache_stats();
+  EXPECT_FALSE(gripper.is_activated().value());
+  EXPECT_EQ(gripper.get_cache_stats().transactions, before.transactions + 1);
+  EXPECT_EQ(gripper.get_feedback()->status.gact,
+            robotiq::ActivationStatus::NOT_ACTIVATED);
+}
+
+TEST(register_shadow, skips_redundant_transactions) {
+  robotiq::RobotiqGripperInterface gripper;
+  ASSERT_TRUE(gripper.connect(std::make_unique<robotiq::SimulatedGripper>()));
+  gripper.set_timeout(20);
+  ASSERT_TRUE(gripper.activate(false));
+  while (not gripper.is_activated().value()) {
+  }
+  ASSERT_TRUE(gripper.set_gripper_position(0.5));
+
+  // Without a freshness window every call is a transaction
+  robotiq::RegisterCacheStats before = gripper.get_cache_stats();
+  ASSERT_TRUE(gripper.set_gripper_position(0.5, false));
+  ASSERT_TRUE(gripper.is_activated().value());
+  robotiq::RegisterCacheStats after = gripper.get_cache_stats();
+  EXPECT_EQ(after.transactions, before.transactions + 2);
+  EXPECT_EQ(after.skipped_writes, 0u);
+  EXPECT_EQ(after.cached_reads, 0u);
+
+  // Within the window, the repeated target and the status come from the shadow
+  gripper.set_cache_freshness(1000);
+  ASSERT_TRUE(gripper.get_feedback());
+  before = gripper.get_cache_stats();
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(gripper.set_gripper_position(0.5, false));
+    EXPECT_TRUE(gripper.is_activated().value());
+  }
+  ASSERT_TRUE(gripper.set_gripper_position(0.5));
+  after = gripper.get_cache_stats();
+  EXPECT_EQ(after.skipped_writes, before.skipped_writes + 6);
+  EXPECT_EQ(after.cached_reads, before.cached_reads + 5);
+  EXPECT_EQ(after.transactions, before.transactions + 1);  // Poll of the blocking move
+
+  // A new target or speed is sent, and readdressing forgets the shadow
+  ASSERT_TRUE(gripper.set_gripper_position(0.5, 0.5, 1));
+  ASSERT_TRUE(gripper.set_gripper_position(0.6));
+  EXPECT_EQ(gripper.get_feedback()->raw_commanded_position, 153);
+  before = gripper.get_cache_stats();
+  EXPECT_EQ(before.skipped_writes, after.skipped_writes);
+  gripper.set_slave_id(robotiq::DEFAULT_SLAVE_ID);
+  ASSERT_TRUE(gripper.is_activated().value());
+  EXPECT_EQ(gripper.get_cache_stats().transactions, before.transactions + 1);
+}
@@ -0,0 +1,94 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/result.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+namespace {
+
+/** Returns the error of a status read through the impairments */
+robotiq::ErrorCode read_status_error(const robotiq::ImpairmentProfile& profile) {
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.connect(std::make_unique<robotiq::ImpairedTransport>(
+      std::make_unique<robotiq::SimulatedGripper>(), profile));
+  gripper.set_timeout(20);
+  return gripper.get_feedback().error();
+}
+
+}  // namespace
+
+TEST(result, value_and_error) {
+  robotiq::Result<int> value = 3;
+  EXPECT_TRUE(value);
+  EXPECT_EQ(*value, 3);
+  EXPECT_EQ(value.error(), robotiq::ErrorCode::NONE);
+
+  robotiq::Result<int> error = robotiq::ErrorCode::TIMEOUT;
+  EXPECT_FALSE(error);
+  EXPECT_EQ(error.value(), 0);
+  EXPECT_STREQ(error.message(), "response timeout");
+
+  std::error_code code = robotiq::ErrorCode::BAD_CRC;
+  EXPECT_EQ(code.category().name(), std::string("robotiq"));
+  EXPECT_EQ(code.message(), "bad response crc");
+}
+
+TEST(result, not_connected) {
+  robotiq::RobotiqGripperInterface gripper;
+  EXPECT_EQ(gripper.get_feedback().error(), robotiq::ErrorCode::NOT_CONNECTED);
+  EXPECT_EQ(gripper.close_gripper().error(), robotiq::ErrorCode::NOT_CONNECTED);
+  EXPECT_EQ(gripper.connect("/dev/does_not_exist").error(),
+            robotiq::ErrorCode::PORT_ERROR);
+}
+
+TEST(result, bus_errors) {
+  robotiq::ImpairmentProfile truncated;
+  truncated.truncate_probability = 1;
+  EXPECT_EQ(read_status_error(truncated), robotiq::ErrorCode::TIMEOUT);
+
+  // CRC-16 detects every single bit error, wherever the bit lands
+  robotiq::ImpairmentProfile flipped;
+  flipped.flip_bit_probability = 1;
+  for (uint32_t seed = 0; seed < 20; ++seed) {
+    flipped.seed = seed;
+    EXPECT_EQ(read_status_error(flipped), robotiq::ErrorCode::BAD_CRC);
+  }
+
+  robotiq::ImpairmentProfile port_loss;
+  port_loss.port_loss_probability = 1;
+  EXPECT_EQ(read_status_error(port_loss), robotiq::ErrorCode::PORT_ERROR);
+}
+
+TEST(result, modbus_exception) {
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.connect(std::make_unique<robotiq::SimulatedGripper>());
+  std::vector<uint16_t> values;
+  EXPECT_EQ(gripper.read_registers(0x0000, 3, values).error(),
+            robotiq::ErrorCode::MODBUS_EXCEPTION);
+  EXPECT_EQ(gripper.read_registers(0x07D0, 0, values).error(),
+            robotiq::ErrorCode::INVALID_ARGUMENT);
+}
+
+TEST(result, motion_timeout) {
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.connect(std::make_unique<robotiq::SimulatedGripper>());
+  gripper.activate(false);
+  gripper.set_motion_timeout(50);
+  EXPECT_EQ(gripper.close_gripper().error(), robotiq::ErrorCode::MOTION_TIMEOUT);
+  gripper.set_motion_timeout(robotiq::DEFAULT_MOTION_TIMEOUT_MS);
+  EXPECT_TRUE(gripper.close_gripper());
+}
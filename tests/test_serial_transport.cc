@@ -0,0 +1,51 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/transport.h"
+
+TEST(serial_transport, low_latency_falls_back_on_pty) {
+  int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+  ASSERT_GE(master, 0);
+  ASSERT_EQ(::grantpt(master), 0);
+  ASSERT_EQ(::unlockpt(master), 0);
+
+  // A pty has termios but no serial driver flags or RS-485 control
+  robotiq::SerialTransport transport;
+  robotiq::SerialOptions options;
+  options.low_latency = true;
+  std::string error;
+  ASSERT_TRUE(transport.open(::ptsname(master), robotiq::DEFAULT_BAUD, error, options));
+  const robotiq::SerialLatencyReport& report = transport.latency_report();
+  EXPECT_TRUE(report.raw_termios);
+  EXPECT_FALSE(report.low_latency);
+  EXPECT_FALSE(report.rs485);
+  EXPECT_TRUE(report.flushed);
+  EXPECT_EQ(to_string(report), "raw_termios=yes low_latency=no rs485=no flushed=yes");
+
+  // Raw mode passes every byte through untranslated
+  const char bytes[] = {'\r', '\n', 0x11, 0x7F};
+  ASSERT_EQ(::write(master, bytes, sizeof(bytes)), static_cast<ssize_t>(sizeof(bytes)));
+  for (char expected : bytes) {
+    char c;
+    ASSERT_TRUE(transport.read_byte(c, 100));
+    EXPECT_EQ(c, expected);
+  }
+  ::close(master);
+}
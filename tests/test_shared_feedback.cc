@@ -0,0 +1,119 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "robotiq/shared_feedback.h"
+#include "src/shared_feedback_publisher.h"
+
+static const std::string TEST_NAME = "/robotiq_gripper_test";
+
+TEST(shared_feedback, latest_and_history) {
+  robotiq::SharedFeedbackPublisher publisher;
+  ASSERT_TRUE(publisher.open(TEST_NAME));
+
+  robotiq::SharedFeedbackReader reader;
+  ASSERT_TRUE(reader.connect(TEST_NAME));
+
+  robotiq::shm::Sample sample;
+  EXPECT_FALSE(reader.latest(sample));
+
+  for (int i = 0; i < 300; ++i) {
+    robotiq::GripperFeedback feedback;
+    feedback.raw_position = static_cast<uint8_t>(i);
+    publisher.publish(feedback);
+  }
+
+  ASSERT_TRUE(reader.latest(sample));
+  EXPECT_EQ(sample.index, 299u);
+  EXPECT_EQ(sample.feedback.raw_position, static_cast<uint8_t>(299));
+
+  std::vector<robotiq::shm::Sample> history = reader.history(10);
+  ASSERT_EQ(history.size(), 10u);
+  EXPECT_EQ(history.front().index, 290u);
+  EXPECT_EQ(history.back().index, 299u);
+  EXPECT_EQ(reader.history(1000).size(), robotiq::shm::HISTORY_CAPACITY);
+}
+
+TEST(shared_feedback, command_queue) {
+  robotiq::SharedFeedbackPublisher publisher;
+  ASSERT_TRUE(publisher.open(TEST_NAME));
+
+  robotiq::SharedFeedbackReader reader;
+  ASSERT_TRUE(reader.connect(TEST_NAME));
+
+  for (std::size_t i = 0; i < robotiq::shm::COMMAND_CAPACITY; ++i) {
+    EXPECT_TRUE(reader.send({robotiq::shm::COMMAND_POSITION, static_cast<double>(i)}));
+  }
+  EXPECT_FALSE(reader.send({robotiq::shm::COMMAND_CLOSE, 0}));
+
+  robotiq::shm::Command command;
+  for (std::size_t i = 0; i < robotiq::shm::COMMAND_CAPACITY; ++i) {
+    ASSERT_TRUE(publisher.pop(command));
+    EXPECT_EQ(command.position, static_cast<double>(i));
+  }
+  EXPECT_FALSE(publisher.pop(command));
+}
+
+TEST(shared_feedback, dead_publisher_does_not_block_readers) {
+  robotiq::SharedFeedbackPublisher publisher;
+  ASSERT_TRUE(publisher.open(TEST_NAME));
+  publisher.publish(robotiq::GripperFeedback{});
+  robotiq::SharedFeedbackReader reader;
+  ASSERT_TRUE(reader.connect(TEST_NAME));
+
+  // A publisher that died while writing leaves the sequence of the slot odd
+  int fd = shm_open(TEST_NAME.c_str(), O_RDWR, 0);
+  ASSERT_GE(fd, 0);
+  void* address = mmap(nullptr, sizeof(robotiq::shm::Segment), PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+  close(fd);
+  ASSERT_NE(address, MAP_FAILED);
+  auto* segment = static_cast<robotiq::shm::Segment*>(address);
+  segment->samples[0].sequence.fetch_add(1);
+
+  robotiq::shm::Sample sample;
+  EXPECT_FALSE(reader.latest(sample));
+  segment->samples[0].sequence.fetch_add(1);
+  EXPECT_TRUE(reader.latest(sample));
+  munmap(address, sizeof(robotiq::shm::Segment));
+}
+
+TEST(shared_feedback, segment_permissions) {
+  robotiq::SharedFeedbackPublisher publisher;
+  struct stat status;
+  for (uint32_t mode : {robotiq::DEFAULT_SHARED_FEEDBACK_MODE, 0660u}) {
+    ASSERT_TRUE(publisher.open(TEST_NAME, mode));
+    int fd = shm_open(TEST_NAME.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(fstat(fd, &status), 0);
+    close(fd);
+    EXPECT_EQ(status.st_mode & 0777, mode);
+  }
+}
+
+TEST(shared_feedback, rejects_segment_being_created) {
+  // The publisher creates the object before sizing and initializing it
+  shm_unlink(TEST_NAME.c_str());
+  int fd = shm_open(TEST_NAME.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  robotiq::SharedFeedbackReader reader;
+  EXPECT_FALSE(reader.connect(TEST_NAME));
+
+  // Sized but not initialized, the magic is still zero
+  ASSERT_EQ(ftruncate(fd, sizeof(robotiq::shm::Segment)), 0);
+  close(fd);
+  EXPECT_FALSE(reader.connect(TEST_NAME));
+  shm_unlink(TEST_NAME.c_str());
+}
@@ -0,0 +1,152 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+#include "tests/simulation_fixture.h"
+
+TEST(simulation, move_and_stop_on_object) {
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq::SimulatedGripper* simulated = robotiq_tests::connect_simulated(gripper);
+  EXPECT_TRUE(gripper.is_activated().value());
+
+  simulated->set_object(100);
+  EXPECT_TRUE(gripper.close_gripper());
+  robotiq::GripperFeedback y = gripper.get_feedback().value();
+  EXPECT_EQ(y.status.gobj, robotiq::ObjectStatus::STOPPED_WHILE_CLOSING);
+  EXPECT_EQ(y.raw_position, 100);
+
+  simulated->set_object(-1);
+  EXPECT_TRUE(gripper.open_gripper());
+  y = gripper.get_feedback().value();
+  EXPECT_EQ(y.status.gobj, robotiq::ObjectStatus::AT_REQUESTED_POSITION);
+  EXPECT_EQ(y.raw_position, 0);
+
+  simulated->set_fault(robotiq::FaultStatus::OVERCURRENT);
+  EXPECT_EQ(gripper.get_feedback()->status.gflt, robotiq::FaultStatus::OVERCURRENT);
+}
+
+TEST(simulation, grasp_switches_to_contact_inside_margin) {
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq::SimulatedGripper* simulated = robotiq_tests::connect_simulated(gripper);
+
+  // The approach ends at word 127, the object lies between it and the expected width
+  robotiq::GraspProfile profile;
+  profile.expected_width = 0.6;
+  profile.slowdown_margin = 0.1;
+  profile.contact_speed = 0.2;
+  profile.contact_force = 0.2;
+  simulated->set_object(140);
+  robotiq::Result<bool> grasped = gripper.grasp(profile);
+  ASSERT_TRUE(grasped.has_value());
+  EXPECT_TRUE(grasped.value());
+
+  // The fingers stopped on the object under the slow contact command
+  robotiq::GripperFeedback y = gripper.get_feedback().value();
+  EXPECT_EQ(y.status.gobj, robotiq::ObjectStatus::STOPPED_WHILE_CLOSING);
+  EXPECT_EQ(y.raw_position, 140);
+  EXPECT_EQ(y.raw_commanded_position, 255);
+  std::vector<uint16_t> outputs;
+  ASSERT_TRUE(gripper.read_registers(0x03E8, 3, outputs));
+  EXPECT_EQ(outputs[2], 0x3333);  // Contact speed and force words
+
+  // An object before the slowdown margin is grasped by the approach
+  ASSERT_TRUE(gripper.open_gripper());
+  simulated->set_object(100);
+  grasped = gripper.grasp(profile);
+  ASSERT_TRUE(grasped.has_value());
+  EXPECT_TRUE(grasped.value());
+  y = gripper.get_feedback().value();
+  EXPECT_EQ(y.raw_position, 100);
+  EXPECT_EQ(y.raw_commanded_position, 127);
+}
+
+TEST(simulation, grasp_reports_empty_gripper_and_timeout) {
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq_tests::connect_simulated(gripper);
+  robotiq::GraspProfile profile;
+  profile.expected_width = 0.6;
+  profile.slowdown_margin = 0.1;
+  profile.contact_speed = 1;
+
+  // Without an object the fingers close completely
+  robotiq::Result<bool> grasped = gripper.grasp(profile);
+  ASSERT_TRUE(grasped.has_value());
+  EXPECT_FALSE(grasped.value());
+  EXPECT_EQ(gripper.get_feedback()->status.gobj,
+            robotiq::ObjectStatus::AT_REQUESTED_POSITION);
+
+  ASSERT_TRUE(gripper.open_gripper());
+  gripper.set_motion_timeout(50);
+  EXPECT_EQ(gripper.grasp(profile).error(), robotiq::ErrorCode::MOTION_TIMEOUT);
+}
+
+TEST(simulation, injected_fault_keeps_valid_crc) {
+  robotiq::ImpairmentProfile profile;
+  profile.fault_probability = 1;
+  profile.fault = robotiq::FaultStatus::UNDER_VOLTAGE;
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq_tests::connect_simulated(gripper, profile);
+
+  robotiq::GripperFeedback y = gripper.get_feedback().value();
+  EXPECT_EQ(y.status.gact, robotiq::ActivationStatus::ACTIVATED);
+  EXPECT_EQ(y.status.gflt, robotiq::FaultStatus::UNDER_VOLTAGE);
+}
+
+TEST(simulation, corrupted_responses_are_rejected) {
+  robotiq::ImpairmentProfile profile;
+  profile.seed = 7;
+  profile.flip_bit_probability = 0.3;
+  profile.drop_byte_probability = 0.3;
+  profile.truncate_probability = 0.3;
+
+  // The same seed gives the same impairments
+  std::vector<bool> outcomes[2];
+  for (auto& outcome : outcomes) {
+    robotiq::RobotiqGripperInterface gripper;
+    robotiq_tests::connect_simulated(gripper, profile);
+    for (int i = 0; i < 40; ++i) {
+      std::vector<uint16_t> values;
+      bool success = gripper.read_registers(0x03E8, 3, values).has_value();
+      outcome.push_back(success);
+      if (success) {
+        EXPECT_EQ(values, std::vector<uint16_t>({0x0100, 0x0000, 0x0000}));
+      }
+    }
+  }
+  EXPECT_EQ(outcomes[0], outcomes[1]);
+  EXPECT_NE(std::count(outcomes[0].begin(), outcomes[0].end(), false), 0);
+  EXPECT_NE(std::count(outcomes[0].begin(), outcomes[0].end(), true), 0);
+}
+
+TEST(simulation, port_loss) {
+  robotiq::ImpairmentProfile profile;
+  profile.port_loss_probability = 1;
+  profile.port_loss_ms = 1000;
+  auto impaired = std::make_unique<robotiq::ImpairedTransport>(
+      std::make_unique<robotiq::SimulatedGripper>(), profile);
+  robotiq::ImpairedTransport* raw = impaired.get();
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.connect(std::move(impaired));
+
+  std::vector<uint16_t> values;
+  EXPECT_FALSE(gripper.read_registers(0x07D0, 3, values));
+  EXPECT_FALSE(gripper.read_registers(0x07D0, 3, values));
+  EXPECT_EQ(raw->counters().port_losses, 1u);
+}
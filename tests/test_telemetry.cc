@@ -0,0 +1,60 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/telemetry.h"
+#include "src/telemetry_recorder.h"
+
+TEST(telemetry, record_and_seek) {
+  std::string path = testing::TempDir() + "robotiq_telemetry_test.bin";
+  const std::size_t count = 3 * robotiq::TELEMETRY_RECORDS_PER_BLOCK + 10;
+  const int64_t start_ns = 1000000000;
+  const int64_t period_ns = 5000000;  // 200 Hz
+
+  robotiq::TelemetryRecorder recorder;
+  ASSERT_TRUE(recorder.open(path));
+  for (std::size_t i = 0; i < count; ++i) {
+    robotiq::TelemetrySample sample;
+    sample.stamp_ns = start_ns + i * period_ns;
+    sample.latency_us = 1500;
+    sample.flags = robotiq::RECORD_RESPONSE_VALID;
+    sample.registers[4] = static_cast<uint8_t>(i);
+    recorder.record(sample);
+    if (i % 1000 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  recorder.close();
+  EXPECT_EQ(recorder.dropped(), 0u);
+
+  robotiq::TelemetryReader reader;
+  ASSERT_TRUE(reader.open(path));
+  ASSERT_EQ(reader.size(), count);
+
+  robotiq::TelemetrySample sample = reader.at(5000);
+  EXPECT_EQ(sample.stamp_ns, start_ns + 5000 * period_ns);
+  EXPECT_EQ(sample.latency_us, 1500u);
+  EXPECT_EQ(sample.registers[4], static_cast<uint8_t>(5000));
+
+  EXPECT_EQ(reader.seek(0), 0u);
+  EXPECT_EQ(reader.seek(start_ns + 5000 * period_ns), 5000u);
+  EXPECT_EQ(reader.seek(start_ns + 5000 * period_ns + 1), 5001u);
+  EXPECT_EQ(reader.seek(start_ns + count * period_ns), count);
+
+  reader.close();
+  std::remove(path.c_str());
+}
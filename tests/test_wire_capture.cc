@@ -0,0 +1,84 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <deque>
+
+#include <gtest/gtest.h>
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/transport.h"
+#include "src/helpers.h"
+
+namespace {
+
+/** Answers every write with a feedback response holding the given position */
+class FeedbackTransport : public robotiq::Transport {
+ public:
+  explicit FeedbackTransport(uint8_t position) : m_position(position) {}
+
+  bool write(const std::string&) override {
+    std::string response = "09030639000000" + robotiq::uint8_to_hex(m_position) + "00";
+    response += robotiq::crc16_modbus(response);
+    std::string bin = robotiq::hex_to_bin(response);
+    m_pending.insert(m_pending.end(), bin.begin(), bin.end());
+    return true;
+  }
+
+  bool read_byte(char& c, std::size_t) override {
+    if (m_pending.empty()) {
+      return false;
+    }
+    c = m_pending.front();
+    m_pending.pop_front();
+    return true;
+  }
+
+  void flush_input() override { m_pending.clear(); }
+
+ private:
+  uint8_t m_position;
+  std::deque<char> m_pending;
+};
+
+}  // namespace
+
+TEST(wire_capture, capture_and_replay) {
+  std::string path = testing::TempDir() + "robotiq_wire_capture_test.bin";
+
+  {
+    auto capture = std::make_unique<robotiq::CaptureTransport>(
+        std::make_unique<FeedbackTransport>(42));
+    ASSERT_TRUE(capture->open(path));
+    robotiq::RobotiqGripperInterface gripper;
+    ASSERT_TRUE(gripper.connect(std::move(capture)));
+    EXPECT_EQ(gripper.get_feedback()->raw_position, 42);
+    EXPECT_EQ(gripper.get_feedback()->raw_position, 42);
+  }
+
+  auto replay = std::make_unique<robotiq::ReplayTransport>();
+  ASSERT_TRUE(replay->open(path, 0));
+  robotiq::ReplayTransport* replay_ptr = replay.get();
+
+  robotiq::RobotiqGripperInterface gripper;
+  ASSERT_TRUE(gripper.connect(std::move(replay)));
+  robotiq::GripperFeedback feedback = gripper.get_feedback().value();
+  EXPECT_EQ(feedback.raw_position, 42);
+  EXPECT_EQ(feedback.status.gact, robotiq::ActivationStatus::ACTIVATED);
+  EXPECT_EQ(gripper.get_feedback()->raw_position, 42);
+  EXPECT_TRUE(replay_ptr->finished());
+  EXPECT_EQ(replay_ptr->mismatches(), 0u);
+
+  std::remove(path.c_str());
+}
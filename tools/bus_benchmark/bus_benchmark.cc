@@ -0,0 +1,235 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how the throughput and tail latency of RobotiqGripperInterface degrade under
+// the bus conditions seen on the factory floor.  Every impairment profile alternates
+// status reads and position commands through an ImpairedTransport, in front of a
+// simulated gripper or of a serial port such as a pty, and reports the latency
+// percentiles and how long the interface took to recover from each failure.
+// Transactions are paced at a poll period, so that outages such as a lost port last
+// over several transactions as they would for a controller.
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Define the communication parameters
+std::string port = "";
+std::size_t baud = robotiq::DEFAULT_BAUD;
+std::size_t transactions = 500;
+std::size_t timeout_ms = 20;
+std::size_t period_us = 5000;
+uint32_t seed = 1;
+std::string profile_name = "";
+bool low_latency = false;
+
+struct NamedProfile {
+  std::string name;
+  robotiq::ImpairmentProfile profile;
+};
+
+// Impairment profiles, the probabilities are per response frame
+std::vector<NamedProfile> make_profiles() {
+  std::vector<NamedProfile> profiles(9);
+  profiles[0].name = "clean";
+  profiles[1].name = "dropped_bytes";
+  profiles[1].profile.drop_byte_probability = 0.01;
+  profiles[2].name = "bit_flips";
+  profiles[2].profile.flip_bit_probability = 0.01;
+  profiles[3].name = "partial_frames";
+  profiles[3].profile.truncate_probability = 0.01;
+  profiles[4].name = "slow_first_byte";
+  profiles[4].profile.delay_probability = 0.05;
+  profiles[4].profile.delay_us = 5000;
+  profiles[5].name = "overcurrent";
+  profiles[5].profile.fault_probability = 0.01;
+  profiles[5].profile.fault = robotiq::FaultStatus::OVERCURRENT;
+  profiles[6].name = "under_voltage";
+  profiles[6].profile.fault_probability = 0.01;
+  profiles[6].profile.fault = robotiq::FaultStatus::UNDER_VOLTAGE;
+  profiles[7].name = "port_loss";
+  profiles[7].profile.port_loss_probability = 0.004;
+  profiles[7].profile.port_loss_ms = 10;
+  profiles[8].name = "factory_floor";
+  profiles[8].profile.drop_byte_probability = 0.002;
+  profiles[8].profile.flip_bit_probability = 0.002;
+  profiles[8].profile.truncate_probability = 0.002;
+  profiles[8].profile.delay_probability = 0.01;
+  profiles[8].profile.delay_us = 5000;
+  profiles[8].profile.fault_probability = 0.002;
+  profiles[8].profile.fault = robotiq::FaultStatus::OVERCURRENT;
+  for (auto& profile : profiles) {
+    profile.profile.seed = seed;
+  }
+  return profiles;
+}
+
+bool parse_args(int argc, char* argv[]) {
+  for (int i = 1; i < argc; i += 2) {
+    if (std::string(argv[i]) == "--help" || i + 1 >= argc) {
+      std::cout << "  --port <value> Optional serial port ID, e.g. a pty (default: "
+                   "simulated gripper)\n";
+      std::cout << "  --baud <value> Optional baud rate\n";
+      std::cout << "  --transactions <value> Transactions per profile (default: 500)\n";
+      std::cout << "  --timeout <value> Inactivity timeout in ms (default: 20)\n";
+      std::cout << "  --period <value> Poll period in us, 0 for back to back "
+                   "(default: 5000)\n";
+      std::cout << "  --seed <value> Seed of the impairments (default: 1)\n";
+      std::cout << "  --profile <value> Run a single profile\n";
+      std::cout << "  --low-latency <0|1> Low-latency serial mode (default: 0)\n";
+      return false;
+    } else if (std::string(argv[i]) == "--port") {
+      port = std::string(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--baud") {
+      baud = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--transactions") {
+      transactions = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--timeout") {
+      timeout_ms = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--period") {
+      period_us = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--seed") {
+      seed = static_cast<uint32_t>(std::atoi(argv[i + 1]));
+    } else if (std::string(argv[i]) == "--profile") {
+      profile_name = std::string(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--low-latency") {
+      low_latency = std::atoi(argv[i + 1]) != 0;
+    }
+  }
+  return true;
+}
+
+// Opens the transport to impair
+std::unique_ptr<robotiq::Transport> open_transport() {
+  if (port.empty()) {
+    robotiq::SimulatedGripperConfig config;
+    config.baud = baud;
+    return std::make_unique<robotiq::SimulatedGripper>(config);
+  }
+  auto transport = std::make_unique<robotiq::SerialTransport>();
+  std::string error;
+  robotiq::SerialOptions options;
+  options.low_latency = low_latency;
+  if (not transport->open(port, baud, error, options)) {
+    std::cout << "Failed to open " << port << ": " << error << "\n";
+    return nullptr;
+  }
+
+  // Report the settings once, before the first profile
+  static bool reported = false;
+  if (low_latency && not reported) {
+    std::cout << "Low-latency settings: " << to_string(transport->latency_report())
+              << "\n";
+    reported = true;
+  }
+  return transport;
+}
+
+// Returns the latency at a percentile of sorted latencies
+double percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  std::size_t index = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[index];
+}
+
+int main(int argc, char* argv[]) {
+  // Load the args
+  if (not parse_args(argc, argv)) {
+    return 0;
+  }
+
+  std::printf("%-16s %6s %6s %6s %9s %9s %9s %9s %9s %12s\n", "profile", "tx",
+              "failed", "faults", "tx/s", "p50_us", "p99_us", "p99.9_us", "max_us",
+              "recovery_ms");
+
+  using Clock = std::chrono::steady_clock;
+  for (const auto& named : make_profiles()) {
+    if (not profile_name.empty() && named.name != profile_name) {
+      continue;
+    }
+    auto transport = open_transport();
+    if (transport == nullptr) {
+      return 1;
+    }
+    auto impaired =
+        std::make_unique<robotiq::ImpairedTransport>(std::move(transport), named.profile);
+    robotiq::RobotiqGripperInterface gripper;
+    gripper.connect(std::move(impaired));
+    gripper.set_timeout(timeout_ms);
+
+    // Alternate status reads and position commands, activating the gripper first
+    gripper.write_registers(0x03E8, {0x0100, 0x0000, 0x0000});
+    std::vector<double> latencies;
+    std::size_t failed = 0;
+    std::size_t faults = 0;
+    double max_recovery_ms = 0;
+    bool recovering = false;
+    Clock::time_point failure;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < transactions; ++i) {
+      // Failed transactions return early, the next one still waits for its period
+      std::this_thread::sleep_until(start + i * std::chrono::microseconds(period_us));
+      auto sent = Clock::now();
+      bool success;
+      if (i % 2 == 0) {
+        std::vector<uint16_t> status;
+        success = gripper.read_registers(0x07D0, 3, status).has_value();
+        faults += success && ((status[1] >> 8) & 0x0F) != 0;
+      } else {
+        uint16_t position = (i / 2) % 2 == 0 ? 0x00FF : 0x0000;
+        success = gripper.write_registers(0x03E8, {0x0900, position, 0xFFFF}).has_value();
+      }
+      auto completed = Clock::now();
+      latencies.push_back(std::chrono::duration<double, std::micro>(completed - sent)
+                              .count());
+
+      // The interface recovered once a transaction succeeds after a failure
+      if (not success) {
+        ++failed;
+        if (not recovering) {
+          recovering = true;
+          failure = sent;
+        }
+      } else if (recovering) {
+        recovering = false;
+        max_recovery_ms = std::max(
+            max_recovery_ms,
+            std::chrono::duration<double, std::milli>(completed - failure).count());
+      }
+    }
+    auto end = Clock::now();
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    if (recovering) {
+      max_recovery_ms =
+          std::max(max_recovery_ms,
+                   std::chrono::duration<double, std::milli>(end - failure).count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%-16s %6zu %6zu %6zu %9.1f %9.0f %9.0f %9.0f %9.0f %12.1f\n",
+                named.name.c_str(), transactions, failed, faults,
+                transactions / elapsed, percentile(latencies, 50),
+                percentile(latencies, 99), percentile(latencies, 99.9),
+                latencies.empty() ? 0 : latencies.back(), max_recovery_ms);
+  }
+  return 0;
+}
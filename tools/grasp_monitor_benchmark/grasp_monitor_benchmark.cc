@@ -0,0 +1,127 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the per-sample cost of GraspMonitor against the feedback poll period.  A
+// synthetic trace of grasp cycles (free closing, contact, holding, slips and a drop) is
+// replayed through the monitor, and the poll period is measured on a simulated gripper.
+
+#include "robotiq/grasp_monitor.h"
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Define the benchmark parameters
+std::size_t samples = 10000000;
+std::size_t window = 8;
+std::size_t polls = 500;
+
+bool parse_args(int argc, char* argv[]) {
+  for (int i = 1; i < argc; i += 2) {
+    if (std::string(argv[i]) == "--help" || i + 1 >= argc) {
+      std::cout << "  --samples <value> Samples analyzed (default: 10000000)\n";
+      std::cout << "  --window <value> Window of the moving statistics (default: 8)\n";
+      std::cout << "  --polls <value> Feedback polls to time (default: 500)\n";
+      return false;
+    } else if (std::string(argv[i]) == "--samples") {
+      samples = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--window") {
+      window = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--polls") {
+      polls = std::atoi(argv[i + 1]);
+    }
+  }
+  return true;
+}
+
+// Creates one grasp cycle: close on an object at 120, hold, slip twice, then drop it
+std::vector<robotiq::GripperFeedback> make_cycle(std::mt19937& random) {
+  using robotiq::ObjectStatus;
+  std::normal_distribution<double> noise(0, 0.005);
+  std::vector<robotiq::GripperFeedback> cycle;
+  auto add = [&](ObjectStatus gobj, double position, double current) {
+    robotiq::GripperFeedback y;
+    y.status.gobj = gobj;
+    y.raw_commanded_position = 255;
+    y.raw_position = static_cast<uint8_t>(position);
+    y.current = current + noise(random);
+    cycle.push_back(y);
+  };
+  for (double position = 0; position < 120; position += 1.5) {
+    add(ObjectStatus::IN_MOTION, position, 0.04);
+  }
+  for (int i = 0; i < 40; ++i) {
+    add(ObjectStatus::STOPPED_WHILE_CLOSING, 120, 0.5);
+  }
+  for (double slip = 120; slip < 130; slip += 0.5) {
+    add(ObjectStatus::IN_MOTION, slip, 0.1);
+  }
+  for (int i = 0; i < 40; ++i) {
+    add(ObjectStatus::STOPPED_WHILE_CLOSING, 130, 0.5);
+  }
+  for (double position = 130; position <= 255; position += 1.5) {
+    add(ObjectStatus::IN_MOTION, position, 0.04);
+  }
+  add(ObjectStatus::AT_REQUESTED_POSITION, 255, 0);
+  return cycle;
+}
+
+// Returns the mean period of blocking feedback polls on a simulated gripper in us
+double poll_period_us() {
+  robotiq::RobotiqGripperInterface gripper;
+  gripper.connect(std::make_unique<robotiq::SimulatedGripper>());
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < polls; ++i) {
+    gripper.get_feedback();
+  }
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count() /
+         std::max<std::size_t>(polls, 1);
+}
+
+int main(int argc, char* argv[]) {
+  // Load the args
+  if (not parse_args(argc, argv)) {
+    return 0;
+  }
+
+  std::mt19937 random(1);
+  std::vector<robotiq::GripperFeedback> trace = make_cycle(random);
+
+  robotiq::GraspMonitorConfig config;
+  config.window = window;
+  robotiq::GraspMonitor monitor(config);
+  std::size_t events[4] = {0, 0, 0, 0};
+  auto start = Clock::now();
+  for (std::size_t i = 0; i < samples; ++i) {
+    ++events[static_cast<int>(monitor.update(trace[i % trace.size()]))];
+  }
+  double update_ns =
+      std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+      std::max<std::size_t>(samples, 1);
+  double poll_us = poll_period_us();
+
+  std::printf("%12s %9s %9s %12s %12s %10s %10s\n", "samples", "contacts", "slips",
+              "lost", "update_ns", "poll_us", "overhead");
+  std::printf("%12zu %9zu %9zu %12zu %12.1f %10.1f %9.4f%%\n", samples, events[1],
+              events[2], events[3], update_ns, poll_us,
+              100.0 * update_ns / (1000.0 * poll_us));
+  return 0;
+}
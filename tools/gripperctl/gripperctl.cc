@@ -0,0 +1,451 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Diagnostic and load tool to qualify serial adapters and cables before deployment:
+//
+//   gripperctl rate            Maximum feedback rate
+//   gripperctl latency         Round-trip latency distribution of feedback reads
+//   gripperctl motion-latency  Latency from a position command to the motion start
+//   gripperctl soak            Periodic polls for hours, with periodic jitter reports
+//   gripperctl simulate        Serves a simulated gripper on a pty
+//
+// The commands run against a serial port, a pty served by "gripperctl simulate", or an
+// in-process simulated gripper without --port, and print their results as JSON.
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "robotiq/simulation.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Define the parameters
+std::string command = "";
+std::string port = "";
+std::size_t baud = robotiq::DEFAULT_BAUD;
+uint8_t slave_id = robotiq::DEFAULT_SLAVE_ID;
+std::size_t timeout_ms = 100;
+bool low_latency = false;
+double duration_s = -1;
+std::size_t samples = 1000;
+double period_ms = 10;
+double report_s = 60;
+
+bool parse_args(int argc, char* argv[]) {
+  if (argc < 2 || std::string(argv[1]) == "--help") {
+    std::cout << "gripperctl <rate|latency|motion-latency|soak|simulate> [options]\n";
+    std::cout << "  --port <value> Serial port or pty (default: in-process simulator)\n";
+    std::cout << "  --baud <value> Optional baud rate\n";
+    std::cout << "  --slave <value> Optional slave id (default: 9)\n";
+    std::cout << "  --timeout <value> Inactivity timeout in ms (default: 100)\n";
+    std::cout << "  --low-latency <0|1> Low-latency serial mode (default: 0)\n";
+    std::cout << "  --duration <value> Run time in s (rate: 10, soak: 3600, "
+                 "simulate: forever)\n";
+    std::cout << "  --samples <value> Samples of latency and motion-latency "
+                 "(default: 1000)\n";
+    std::cout << "  --period <value> Poll period of soak in ms (default: 10)\n";
+    std::cout << "  --report <value> Report interval of soak in s (default: 60)\n";
+    return false;
+  }
+  command = argv[1];
+  for (int i = 2; i + 1 < argc; i += 2) {
+    if (std::string(argv[i]) == "--port") {
+      port = std::string(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--baud") {
+      baud = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--slave") {
+      slave_id = static_cast<uint8_t>(std::atoi(argv[i + 1]));
+    } else if (std::string(argv[i]) == "--timeout") {
+      timeout_ms = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--low-latency") {
+      low_latency = std::atoi(argv[i + 1]) != 0;
+    } else if (std::string(argv[i]) == "--duration") {
+      duration_s = std::atof(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--samples") {
+      samples = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--period") {
+      period_ms = std::atof(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--report") {
+      report_s = std::atof(argv[i + 1]);
+    }
+  }
+  return true;
+}
+
+/**
+ * Distribution of durations in 1 us buckets up to 100 ms, so that hours of samples fit
+ * in a fixed amount of memory.  Longer durations share the last bucket.
+ */
+class Histogram {
+ public:
+  void add(double us) {
+    std::size_t bucket = static_cast<std::size_t>(std::max(us, 0.0));
+    ++m_buckets[std::min(bucket, m_buckets.size() - 1)];
+    ++m_count;
+    m_sum += us;
+    m_sum_squares += us * us;
+    m_max = std::max(m_max, us);
+  }
+
+  void clear() {
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0;
+    m_sum_squares = 0;
+    m_max = 0;
+  }
+
+  std::size_t count() const { return m_count; }
+
+  double percentile(double p) const {
+    uint64_t rank = static_cast<uint64_t>(std::ceil(p / 100.0 * m_count));
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket + 1 < m_buckets.size(); ++bucket) {
+      seen += m_buckets[bucket];
+      if (seen >= std::max<uint64_t>(rank, 1)) {
+        return static_cast<double>(bucket);
+      }
+    }
+    return m_max;
+  }
+
+  std::string json() const {
+    double mean = m_count > 0 ? m_sum / m_count : 0;
+    double variance = m_count > 0 ? m_sum_squares / m_count - mean * mean : 0;
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\"count\": %zu, \"mean_us\": %.1f, \"stddev_us\": %.1f, "
+                  "\"p50_us\": %.0f, \"p90_us\": %.0f, \"p99_us\": %.0f, "
+                  "\"p99.9_us\": %.0f, \"max_us\": %.0f}",
+                  m_count, mean, std::sqrt(std::max(variance, 0.0)), percentile(50),
+                  percentile(90), percentile(99), percentile(99.9), m_max);
+    return buffer;
+  }
+
+ private:
+  std::vector<uint64_t> m_buckets = std::vector<uint64_t>(100001, 0);
+  std::size_t m_count{0};
+  double m_sum{0};
+  double m_sum_squares{0};
+  double m_max{0};
+};
+
+// Returns the microseconds between two time points
+double elapsed_us(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// Prints an error of a command as JSON
+int print_error(const std::string& message) {
+  std::printf("{\"command\": \"%s\", \"error\": \"%s\"}\n", command.c_str(),
+              message.c_str());
+  return 1;
+}
+
+// Connects to the port, or to an in-process simulated gripper without a port
+robotiq::Result<void> connect(robotiq::RobotiqGripperInterface& gripper) {
+  gripper.set_slave_id(slave_id);
+  gripper.set_timeout(timeout_ms);
+  if (port.empty()) {
+    robotiq::SimulatedGripperConfig config;
+    config.baud = baud;
+    config.slave_id = slave_id;
+    return gripper.connect(std::make_unique<robotiq::SimulatedGripper>(config));
+  }
+  robotiq::SerialOptions options;
+  options.low_latency = low_latency;
+  gripper.set_serial_options(options);
+  return gripper.connect(port, baud);
+}
+
+// Reads the feedback back to back
+int run_rate(robotiq::RobotiqGripperInterface& gripper) {
+  double duration = duration_s < 0 ? 10 : duration_s;
+  std::size_t reads = 0;
+  std::size_t failed = 0;
+  auto start = Clock::now();
+  auto deadline = start + std::chrono::duration<double>(duration);
+  while (Clock::now() < deadline) {
+    gripper.get_feedback() ? ++reads : ++failed;
+  }
+  double elapsed = elapsed_us(start, Clock::now()) / 1e6;
+  std::printf("{\"command\": \"rate\", \"duration_s\": %.3f, \"reads\": %zu, "
+              "\"failed\": %zu, \"rate_hz\": %.1f}\n",
+              elapsed, reads, failed, reads / elapsed);
+  return 0;
+}
+
+// Measures the round trip of feedback reads
+int run_latency(robotiq::RobotiqGripperInterface& gripper) {
+  Histogram latency;
+  std::size_t failed = 0;
+  for (std::size_t i = 0; i < samples; ++i) {
+    auto sent = Clock::now();
+    if (gripper.get_feedback()) {
+      latency.add(elapsed_us(sent, Clock::now()));
+    } else {
+      ++failed;
+    }
+  }
+  std::printf("{\"command\": \"latency\", \"samples\": %zu, \"failed\": %zu, "
+              "\"latency\": %s}\n",
+              samples, failed, latency.json().c_str());
+  return 0;
+}
+
+// Measures the time from a position command to the first feedback showing the fingers
+// moving, alternating between two positions near the middle of the stroke.  The command
+// is a register write that waits for its acknowledgement, since a poll sent while the
+// gripper still answers the command would collide with the answer on the bus.
+int run_motion_latency(robotiq::RobotiqGripperInterface& gripper) {
+  robotiq::Result<bool> activated = gripper.is_activated();
+  if (not activated.has_value()) {
+    return print_error(activated.message());
+  }
+  if (not activated.value()) {
+    robotiq::Result<void> activation = gripper.activate();
+    if (not activation) {
+      return print_error(activation.message());
+    }
+  }
+  const uint16_t positions[2] = {102, 127};
+  robotiq::Result<void> moved = gripper.set_gripper_position(positions[0] / 255.0);
+  if (not moved) {
+    return print_error(moved.message());
+  }
+
+  Histogram latency;
+  std::size_t failed = 0;
+  for (std::size_t i = 0; i < samples; ++i) {
+    robotiq::Result<robotiq::GripperFeedback> y = gripper.get_feedback();
+    if (not y) {
+      ++failed;
+      continue;
+    }
+    uint8_t start_position = y->raw_position;
+    uint16_t target = positions[(i + 1) % 2];
+    auto sent = Clock::now();
+    if (not gripper.write_registers(0x03E8, {0x0900, target, 0xFFFF})) {
+      ++failed;
+      continue;
+    }
+
+    // The echo of the command guards against feedback from before the command applied
+    bool started = false;
+    auto deadline = sent + std::chrono::seconds(2);
+    while (not started && Clock::now() < deadline) {
+      y = gripper.get_feedback();
+      started = y && y->raw_commanded_position == target &&
+                y->raw_position != start_position;
+    }
+    if (started) {
+      latency.add(elapsed_us(sent, Clock::now()));
+    } else {
+      ++failed;
+    }
+
+    // Let the move complete before the next sample
+    while (Clock::now() < deadline) {
+      y = gripper.get_feedback();
+      if (y && y->status.gobj != robotiq::ObjectStatus::IN_MOTION) {
+        break;
+      }
+    }
+  }
+  std::printf("{\"command\": \"motion-latency\", \"samples\": %zu, \"failed\": %zu, "
+              "\"latency\": %s}\n",
+              samples, failed, latency.json().c_str());
+  return 0;
+}
+
+// Polls at a fixed period and reports the latency and the jitter of the poll period
+int run_soak(robotiq::RobotiqGripperInterface& gripper) {
+  double duration = duration_s < 0 ? 3600 : duration_s;
+  auto period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(period_ms));
+  auto report_period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(report_s));
+
+  Histogram latency, jitter, total_latency, total_jitter;
+  std::size_t failed = 0, total_failed = 0;
+  auto print = [&](const char* kind, Clock::time_point start, const Histogram& l,
+                   const Histogram& j, std::size_t f) {
+    std::printf("{\"command\": \"soak\", \"report\": \"%s\", \"elapsed_s\": %.1f, "
+                "\"failed\": %zu, \"latency\": %s, \"jitter\": %s}\n",
+                kind, elapsed_us(start, Clock::now()) / 1e6, f, l.json().c_str(),
+                j.json().c_str());
+    std::fflush(stdout);
+  };
+
+  auto start = Clock::now();
+  auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(duration));
+  auto next = start;
+  auto next_report = start + report_period;
+  const double period_us = std::chrono::duration<double, std::micro>(period).count();
+  Clock::time_point previous;
+  while (next < deadline) {
+    std::this_thread::sleep_until(next);
+    auto sent = Clock::now();
+    if (previous != Clock::time_point{}) {
+      double deviation = std::abs(elapsed_us(previous, sent) - period_us);
+      jitter.add(deviation);
+      total_jitter.add(deviation);
+    }
+    previous = sent;
+    if (gripper.get_feedback()) {
+      double us = elapsed_us(sent, Clock::now());
+      latency.add(us);
+      total_latency.add(us);
+    } else {
+      ++failed;
+      ++total_failed;
+    }
+
+    // Skip the periods missed by a slow poll instead of catching up with a burst
+    next += period;
+    while (next < Clock::now()) {
+      next += period;
+    }
+    if (Clock::now() >= next_report) {
+      print("interval", start, latency, jitter, failed);
+      latency.clear();
+      jitter.clear();
+      failed = 0;
+      next_report += report_period;
+    }
+  }
+  print("total", start, total_latency, total_jitter, total_failed);
+  return 0;
+}
+
+// Returns the size of a Modbus RTU request from its first bytes, or SIZE_MAX if unknown
+std::size_t request_size(const std::string& request) {
+  if (request.size() < 2) {
+    return SIZE_MAX;
+  }
+  uint8_t function = static_cast<uint8_t>(request[1]);
+  if (function == 0x03 || function == 0x04 || function == 0x06) {
+    return 8;
+  }
+  if (function == 0x10 && request.size() >= 7) {
+    return 9 + static_cast<uint8_t>(request[6]);
+  }
+  return SIZE_MAX;
+}
+
+// Serves a simulated gripper on a new pty until the duration elapsed, if any
+int run_simulate() {
+  int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+    return print_error("could not create a pty");
+  }
+  std::string slave = ::ptsname(master);
+
+  // Holding the slave open avoids hang-ups on the master between clients
+  int held_slave = ::open(slave.c_str(), O_RDWR | O_NOCTTY);
+  termios tty;
+  if (held_slave < 0 || ::tcgetattr(held_slave, &tty) != 0) {
+    return print_error("could not open the pty");
+  }
+  ::cfmakeraw(&tty);
+  ::tcsetattr(held_slave, TCSANOW, &tty);
+
+  std::printf("{\"command\": \"simulate\", \"port\": \"%s\", \"slave\": %u}\n",
+              slave.c_str(), unsigned(slave_id));
+  std::fflush(stdout);
+
+  robotiq::SimulatedGripperConfig config;
+  config.baud = baud;
+  config.slave_id = slave_id;
+  robotiq::SimulatedGripper gripper(config);
+  auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                     std::chrono::duration<double>(duration_s));
+  std::string received;
+  while (duration_s < 0 || Clock::now() < deadline) {
+    // A request ends at the size given by its function code, or else with a silence.
+    // Requests sent back to back arrive in one read and are served in turn.
+    pollfd fd{master, POLLIN, 0};
+    int wait_ms = received.empty() ? 100 : 2;
+    char buffer[256];
+    while (received.size() < request_size(received) &&
+           ::poll(&fd, 1, wait_ms) > 0 && (fd.revents & POLLIN)) {
+      ssize_t size = ::read(master, buffer, sizeof(buffer));
+      if (size <= 0) {
+        break;
+      }
+      received.append(buffer, static_cast<std::size_t>(size));
+      wait_ms = 2;
+    }
+    if (received.empty()) {
+      continue;
+    }
+    std::string request = received.substr(0, request_size(received));
+    received.erase(0, request.size());
+
+    // The simulator paces the response bytes like the wire, a byte takes well under 1 ms
+    gripper.write(request);
+    char c;
+    std::size_t byte_timeout_ms = 50;
+    while (gripper.read_byte(c, byte_timeout_ms)) {
+      if (::write(master, &c, 1) != 1) {
+        break;
+      }
+      byte_timeout_ms = 1;
+    }
+  }
+  ::close(held_slave);
+  ::close(master);
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  // Load the args
+  if (not parse_args(argc, argv)) {
+    return 0;
+  }
+  if (command == "simulate") {
+    return run_simulate();
+  }
+
+  robotiq::RobotiqGripperInterface gripper;
+  robotiq::Result<void> connected = connect(gripper);
+  if (not connected) {
+    return print_error(connected.message());
+  }
+  if (command == "rate") {
+    return run_rate(gripper);
+  } else if (command == "latency") {
+    return run_latency(gripper);
+  } else if (command == "motion-latency") {
+    return run_motion_latency(gripper);
+  } else if (command == "soak") {
+    return run_soak(gripper);
+  }
+  return print_error("unknown command");
+}
@@ -0,0 +1,435 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Modbus TCP and Unix socket gateway to one or more Robotiq grippers.  The gateway owns
+// the serial lines and serves any number of clients.  Identical register reads that are
+// queued at the same time, with no write queued between them, are coalesced into a
+// single bus transaction whose result is sent to every waiting client, and all
+// transactions of a line are served in arrival order, so that ten monitoring clients
+// cost no more bus bandwidth than one.
+
+#include "robotiq/robotiq_gripper_interface.h"
+#include "transaction_queue.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+using namespace boost;
+
+// Modbus exception codes returned by the gateway
+const uint8_t EXCEPTION_ILLEGAL_FUNCTION = 0x01;
+const uint8_t EXCEPTION_ILLEGAL_DATA_VALUE = 0x03;
+const uint8_t EXCEPTION_GATEWAY_PATH_UNAVAILABLE = 0x0A;
+const uint8_t EXCEPTION_GATEWAY_TARGET_FAILED = 0x0B;
+
+// Size of the Modbus TCP (MBAP) header, including the unit id
+const std::size_t MBAP_HEADER_SIZE = 7;
+
+// Maximum size of a Modbus PDU
+const std::size_t MAX_PDU_SIZE = 253;
+
+// Define the communication parameters
+struct LineConfig {
+  std::string port;
+  uint8_t unit;
+};
+std::vector<LineConfig> lines_config;
+std::size_t baud = robotiq::DEFAULT_BAUD;
+bool low_latency = false;
+unsigned short tcp_port = 5020;
+std::string socket_path = "";
+
+uint16_t get_uint16(const Pdu& pdu, std::size_t offset) {
+  return static_cast<uint16_t>((pdu[offset] << 8) | pdu[offset + 1]);
+}
+
+void put_uint16(Pdu& pdu, uint16_t value) {
+  pdu.push_back(static_cast<uint8_t>(value >> 8));
+  pdu.push_back(static_cast<uint8_t>(value & 0xFF));
+}
+
+Pdu exception_pdu(uint8_t function_code, uint8_t exception_code) {
+  return Pdu{static_cast<uint8_t>(function_code | 0x80), exception_code};
+}
+
+/** Returns the exception code reporting a failed gripper transaction */
+uint8_t exception_code(robotiq::ErrorCode error) {
+  switch (error) {
+    case robotiq::ErrorCode::NOT_CONNECTED:
+    case robotiq::ErrorCode::PORT_ERROR:
+      return EXCEPTION_GATEWAY_PATH_UNAVAILABLE;
+    case robotiq::ErrorCode::INVALID_ARGUMENT:
+      return EXCEPTION_ILLEGAL_DATA_VALUE;
+    default:
+      return EXCEPTION_GATEWAY_TARGET_FAILED;
+  }
+}
+
+/** Returns an exception code if the request is malformed or not supported, else 0 */
+uint8_t validate(const Pdu& request) {
+  if (request.empty()) {
+    return EXCEPTION_ILLEGAL_FUNCTION;
+  }
+  switch (request[0]) {
+    case FC_READ_HOLDING_REGISTERS:
+      if (request.size() != 5 || get_uint16(request, 3) == 0 ||
+          get_uint16(request, 3) > 125) {
+        return EXCEPTION_ILLEGAL_DATA_VALUE;
+      }
+      return 0;
+    case FC_WRITE_SINGLE_REGISTER:
+      return request.size() == 5 ? 0 : EXCEPTION_ILLEGAL_DATA_VALUE;
+    case FC_WRITE_MULTIPLE_REGISTERS:
+      if (request.size() < 6 || get_uint16(request, 3) == 0 ||
+          request[5] != 2 * get_uint16(request, 3) ||
+          request.size() != 6 + static_cast<std::size_t>(request[5])) {
+        return EXCEPTION_ILLEGAL_DATA_VALUE;
+      }
+      return 0;
+    default:
+      return EXCEPTION_ILLEGAL_FUNCTION;
+  }
+}
+
+/**
+ * Owns one serial line and executes the transactions of its TransactionQueue on a
+ * dedicated thread.
+ */
+class BusLine {
+ public:
+  BusLine(asio::io_service& io_service, uint8_t unit)
+      : m_io_service(io_service), m_unit{unit} {}
+
+  ~BusLine() { stop(); }
+
+  bool connect(const std::string& port) {
+    robotiq::SerialOptions options;
+    options.low_latency = low_latency;
+    m_gripper.set_serial_options(options);
+    // The unit id is also the slave id of the gripper on the RS-485 bus
+    m_gripper.set_slave_id(m_unit);
+    return m_gripper.connect(port, baud).has_value();
+  }
+
+  robotiq::SerialLatencyReport serial_report() const {
+    return m_gripper.get_serial_report();
+  }
+
+  void start() {
+    m_running = true;
+    m_thread = std::thread(&BusLine::run, this);
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_running = false;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+  uint8_t unit() const { return m_unit; }
+
+  /** Queues a validated request; the completion is run on the network io_service */
+  void submit(const Pdu& request, Completion completion) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_requests;
+    if (m_queue.push(request, std::move(completion))) {
+      m_condition.notify_one();
+    }
+  }
+
+  /** Prints the number of client requests and bus transactions */
+  void print_statistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::cout << "Unit " << unsigned(m_unit) << ": " << m_requests
+              << " requests served with " << m_transactions << " bus transactions\n";
+  }
+
+ private:
+  void run() {
+    while (true) {
+      std::shared_ptr<Job> job;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return not m_running || not m_queue.empty(); });
+        if (not m_running) {
+          return;
+        }
+        job = m_queue.pop();
+        ++m_transactions;
+      }
+
+      Pdu response = execute(job->request);
+      for (auto& waiter : job->waiters) {
+        m_io_service.post(std::bind(waiter, response));
+      }
+    }
+  }
+
+  Pdu execute(const Pdu& request) {
+    uint8_t function_code = request[0];
+    uint16_t address = get_uint16(request, 1);
+    Pdu response{function_code};
+
+    if (function_code == FC_READ_HOLDING_REGISTERS) {
+      std::vector<uint16_t> values;
+      robotiq::Result<void> result =
+          m_gripper.read_registers(address, get_uint16(request, 3), values);
+      if (not result) {
+        return exception_pdu(function_code, exception_code(result.error()));
+      }
+      response.push_back(static_cast<uint8_t>(2 * values.size()));
+      for (uint16_t value : values) {
+        put_uint16(response, value);
+      }
+      return response;
+    }
+
+    std::vector<uint16_t> values;
+    if (function_code == FC_WRITE_SINGLE_REGISTER) {
+      values.push_back(get_uint16(request, 3));
+    } else {
+      for (std::size_t i = 6; i + 1 < request.size(); i += 2) {
+        values.push_back(get_uint16(request, i));
+      }
+    }
+    robotiq::Result<void> result = m_gripper.write_registers(address, values);
+    if (not result) {
+      return exception_pdu(function_code, exception_code(result.error()));
+    }
+    if (function_code == FC_WRITE_SINGLE_REGISTER) {
+      return request;
+    }
+    response.insert(response.end(), request.begin() + 1, request.begin() + 5);
+    return response;
+  }
+
+  asio::io_service& m_io_service;
+  robotiq::RobotiqGripperInterface m_gripper;
+  uint8_t m_unit;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  TransactionQueue m_queue;
+  bool m_running{false};
+  std::thread m_thread;
+  uint64_t m_requests{0};
+  uint64_t m_transactions{0};
+};
+
+/** A Modbus TCP client connection, over TCP or a Unix socket */
+template <class Socket>
+class Session : public std::enable_shared_from_this<Session<Socket>> {
+ public:
+  Session(Socket socket, std::map<uint8_t, BusLine*>& lines)
+      : m_socket(std::move(socket)), m_lines(lines) {}
+
+  void start() { read_header(); }
+
+ private:
+  void read_header() {
+    auto self = this->shared_from_this();
+    asio::async_read(m_socket, asio::buffer(m_header),
+                     [this, self](const system::error_code& error, std::size_t) {
+                       if (error) {
+                         return;
+                       }
+                       std::size_t length = (m_header[4] << 8) | m_header[5];
+                       if (m_header[2] != 0 || m_header[3] != 0 || length < 2 ||
+                           length > MAX_PDU_SIZE + 1) {
+                         return;
+                       }
+                       read_body(length - 1);
+                     });
+  }
+
+  void read_body(std::size_t size) {
+    auto self = this->shared_from_this();
+    m_request.resize(size);
+    asio::async_read(m_socket, asio::buffer(m_request),
+                     [this, self](const system::error_code& error, std::size_t) {
+                       if (error) {
+                         return;
+                       }
+                       dispatch();
+                     });
+  }
+
+  void dispatch() {
+    auto line = m_lines.find(m_header[6]);
+    if (line == m_lines.end()) {
+      respond(exception_pdu(m_request[0], EXCEPTION_GATEWAY_PATH_UNAVAILABLE));
+      return;
+    }
+    uint8_t exception_code = validate(m_request);
+    if (exception_code != 0) {
+      respond(exception_pdu(m_request[0], exception_code));
+      return;
+    }
+    auto self = this->shared_from_this();
+    line->second->submit(m_request, [this, self](const Pdu& pdu) { respond(pdu); });
+  }
+
+  void respond(const Pdu& pdu) {
+    std::size_t length = pdu.size() + 1;
+    m_response.assign(m_header.begin(), m_header.end());
+    m_response[4] = static_cast<uint8_t>(length >> 8);
+    m_response[5] = static_cast<uint8_t>(length & 0xFF);
+    m_response.insert(m_response.end(), pdu.begin(), pdu.end());
+
+    auto self = this->shared_from_this();
+    asio::async_write(m_socket, asio::buffer(m_response),
+                      [this, self](const system::error_code& error, std::size_t) {
+                        if (not error) {
+                          read_header();
+                        }
+                      });
+  }
+
+  Socket m_socket;
+  std::map<uint8_t, BusLine*>& m_lines;
+  std::array<uint8_t, MBAP_HEADER_SIZE> m_header;
+  Pdu m_request;
+  Pdu m_response;
+};
+
+/** Accepts client connections and starts a session for each */
+template <class Protocol>
+class Server {
+ public:
+  Server(asio::io_service& io_service, const typename Protocol::endpoint& endpoint,
+         std::map<uint8_t, BusLine*>& lines)
+      : m_io_service(io_service), m_acceptor(io_service, endpoint), m_lines(lines) {
+    accept();
+  }
+
+ private:
+  using Socket = typename Protocol::socket;
+
+  void accept() {
+    auto socket = std::make_shared<Socket>(m_io_service);
+    m_acceptor.async_accept(*socket, [this, socket](const system::error_code& error) {
+      if (not error) {
+        std::make_shared<Session<Socket>>(std::move(*socket), m_lines)->start();
+      }
+      accept();
+    });
+  }
+
+  asio::io_service& m_io_service;
+  typename Protocol::acceptor m_acceptor;
+  std::map<uint8_t, BusLine*>& m_lines;
+};
+
+bool parse_args(int argc, char* argv[]) {
+  for (int i = 1; i < argc; i += 2) {
+    if (std::string(argv[i]) == "--help" || i + 1 >= argc) {
+      std::cout << "  --port <value> Serial port ID, repeat for each serial line\n";
+      std::cout << "  --unit <value> Modbus unit id of the previous port, and slave id "
+                   "of its gripper (default: 9)\n";
+      std::cout << "  --baud <value> Optional baud rate\n";
+      std::cout << "  --low-latency <0|1> Low-latency serial mode (default: 0)\n";
+      std::cout << "  --tcp-port <value> Optional Modbus TCP port (default: 5020)\n";
+      std::cout << "  --socket <value> Optional Unix socket path\n";
+      return false;
+    } else if (std::string(argv[i]) == "--port") {
+      lines_config.push_back({std::string(argv[i + 1]), 9});
+    } else if (std::string(argv[i]) == "--unit") {
+      if (lines_config.empty()) {
+        lines_config.push_back({robotiq::DEFAULT_PORT, 9});
+      }
+      lines_config.back().unit = static_cast<uint8_t>(std::atoi(argv[i + 1]));
+    } else if (std::string(argv[i]) == "--baud") {
+      baud = std::atoi(argv[i + 1]);
+    } else if (std::string(argv[i]) == "--low-latency") {
+      low_latency = std::atoi(argv[i + 1]) != 0;
+    } else if (std::string(argv[i]) == "--tcp-port") {
+      tcp_port = static_cast<unsigned short>(std::atoi(argv[i + 1]));
+    } else if (std::string(argv[i]) == "--socket") {
+      socket_path = std::string(argv[i + 1]);
+    }
+  }
+  if (lines_config.empty()) {
+    lines_config.push_back({robotiq::DEFAULT_PORT, 9});
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  // Load the args
+  if (not parse_args(argc, argv)) {
+    return 0;
+  }
+
+  asio::io_service io_service;
+
+  // Open the serial lines
+  std::vector<std::unique_ptr<BusLine>> bus_lines;
+  std::map<uint8_t, BusLine*> lines;
+  for (const auto& config : lines_config) {
+    bus_lines.push_back(std::make_unique<BusLine>(io_service, config.unit));
+    bool connected = bus_lines.back()->connect(config.port);
+    std::cout << "Connected unit " << unsigned(config.unit) << " on " << config.port
+              << ": " << connected << "\n";
+    if (not connected) {
+      return 1;
+    }
+    if (low_latency) {
+      robotiq::SerialLatencyReport report = bus_lines.back()->serial_report();
+      std::cout << "Low-latency settings: " << to_string(report) << "\n";
+    }
+    lines[config.unit] = bus_lines.back().get();
+    bus_lines.back()->start();
+  }
+
+  // Serve the clients
+  Server<asio::ip::tcp> tcp_server(
+      io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), tcp_port), lines);
+  std::cout << "Serving Modbus TCP on port " << tcp_port << "\n";
+
+  std::unique_ptr<Server<asio::local::stream_protocol>> unix_server;
+  if (not socket_path.empty()) {
+    std::remove(socket_path.c_str());
+    unix_server = std::make_unique<Server<asio::local::stream_protocol>>(
+        io_service, asio::local::stream_protocol::endpoint(socket_path), lines);
+    std::cout << "Serving Modbus on Unix socket " << socket_path << "\n";
+  }
+
+  asio::signal_set signals(io_service, SIGINT, SIGTERM);
+  signals.async_wait(
+      [&io_service](const system::error_code&, int) { io_service.stop(); });
+  io_service.run();
+
+  for (auto& line : bus_lines) {
+    line->stop();
+    line->print_statistics();
+  }
+  if (not socket_path.empty()) {
+    std::remove(socket_path.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+// Modbus function codes served by the gateway
+const uint8_t FC_READ_HOLDING_REGISTERS = 0x03;
+const uint8_t FC_WRITE_SINGLE_REGISTER = 0x06;
+const uint8_t FC_WRITE_MULTIPLE_REGISTERS = 0x10;
+
+// A Modbus PDU, from the function code onwards
+using Pdu = std::vector<uint8_t>;
+
+// Called with the response PDU of a request
+using Completion = std::function<void(const Pdu&)>;
+
+/** A bus transaction and the clients waiting for its result */
+struct Job {
+  Pdu request;
+  std::vector<Completion> waiters;
+};
+
+/**
+ * The transactions of one serial line, first in, first out.  A read is coalesced with
+ * an identical read that is still queued, unless a write was queued after it: the
+ * later read must see the written value, so a write ends coalescing into every read
+ * queued before it.  Not thread-safe, the owner serializes access.
+ */
+class TransactionQueue {
+ public:
+  /**
+   * @brief Queues a validated request, or adds its completion to an identical read.
+   *
+   * @return true if a new transaction was queued.
+   */
+  bool push(const Pdu& request, Completion completion) {
+    if (request[0] == FC_READ_HOLDING_REGISTERS) {
+      auto pending = m_pending_reads.find(request);
+      if (pending != m_pending_reads.end()) {
+        pending->second->waiters.push_back(std::move(completion));
+        return false;
+      }
+    } else {
+      m_pending_reads.clear();
+    }
+
+    auto job = std::make_shared<Job>();
+    job->request = request;
+    job->waiters.push_back(std::move(completion));
+    if (request[0] == FC_READ_HOLDING_REGISTERS) {
+      m_pending_reads[request] = job;
+    }
+    m_jobs.push_back(job);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest transaction, which must exist.  Requests pushed from now
+   * on are not coalesced with it, so they never see data sampled before they arrived.
+   */
+  std::shared_ptr<Job> pop() {
+    std::shared_ptr<Job> job = m_jobs.front();
+    m_jobs.pop_front();
+    auto pending = m_pending_reads.find(job->request);
+    if (pending != m_pending_reads.end() && pending->second == job) {
+      m_pending_reads.erase(pending);
+    }
+    return job;
+  }
+
+  bool empty() const { return m_jobs.empty(); }
+
+ private:
+  std::deque<std::shared_ptr<Job>> m_jobs;
+  std::map<Pdu, std::shared_ptr<Job>> m_pending_reads;
+};